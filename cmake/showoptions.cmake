@@ -84,6 +84,13 @@ else()
     message("* Use coreside debug     : No  (default)")
 endif()
 
+if(WITH_PROFILER)
+    message("* Use zone profiler      : Yes")
+    add_definitions(-DFC_PROFILER)
+else()
+    message("* Use zone profiler      : No  (default)")
+endif()
+
 if(NOT WITH_SOURCE_TREE STREQUAL "no")
     message("* Show source tree       : Yes (${WITH_SOURCE_TREE})")
 else()
@@ -0,0 +1,129 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LATENCYHISTOGRAM_H__
+#define LATENCYHISTOGRAM_H__
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+/// Counts of latencies in power of two microsecond buckets, bucket N holding
+/// samples below 2^N us. Recording is lock free and may happen from any
+/// thread; a snapshot taken concurrently may miss samples being recorded.
+class LatencyHistogram
+{
+public:
+    static constexpr uint32 BUCKET_COUNT = 32;
+
+    struct Snapshot
+    {
+        std::array<uint64, BUCKET_COUNT> Buckets = { };
+        uint64 Count = 0;
+        uint64 TotalMicroseconds = 0;
+        uint64 MaxMicroseconds = 0;
+
+        uint64 GetAverage() const { return Count ? TotalMicroseconds / Count : 0; }
+
+        /// Upper bound of the bucket holding the requested percentile (0-100)
+        uint64 GetPercentile(double percentile) const
+        {
+            if (!Count)
+                return 0;
+
+            uint64 rank = uint64(double(Count) * percentile / 100.0 + 0.5);
+            if (!rank)
+                rank = 1;
+
+            uint64 seen = 0;
+            for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+            {
+                seen += Buckets[i];
+                if (seen >= rank)
+                    return std::min(GetBucketUpperBound(i), MaxMicroseconds);
+            }
+
+            return MaxMicroseconds;
+        }
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(LatencyHistogram const&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram const&) = delete;
+
+    void Record(uint64 microseconds)
+    {
+        _buckets[GetBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _total.fetch_add(microseconds, std::memory_order_relaxed);
+
+        uint64 max = _max.load(std::memory_order_relaxed);
+        while (microseconds > max && !_max.compare_exchange_weak(max, microseconds, std::memory_order_relaxed))
+            ;
+    }
+
+    uint64 GetCount() const { return _count.load(std::memory_order_relaxed); }
+
+    Snapshot GetSnapshot() const
+    {
+        Snapshot snapshot;
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+            snapshot.Buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        snapshot.Count = _count.load(std::memory_order_relaxed);
+        snapshot.TotalMicroseconds = _total.load(std::memory_order_relaxed);
+        snapshot.MaxMicroseconds = _max.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /// Returns the samples recorded since the previous call and starts over,
+    /// used for interval based reporting
+    Snapshot TakeSnapshot()
+    {
+        Snapshot snapshot;
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+            snapshot.Buckets[i] = _buckets[i].exchange(0, std::memory_order_relaxed);
+        snapshot.Count = _count.exchange(0, std::memory_order_relaxed);
+        snapshot.TotalMicroseconds = _total.exchange(0, std::memory_order_relaxed);
+        snapshot.MaxMicroseconds = _max.exchange(0, std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    static uint32 GetBucketIndex(uint64 microseconds)
+    {
+        uint32 index = 0;
+        while (microseconds && index < BUCKET_COUNT - 1)
+        {
+            microseconds >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    static uint64 GetBucketUpperBound(uint32 index)
+    {
+        return index ? (uint64(1) << index) - 1 : 0;
+    }
+
+private:
+    std::array<std::atomic<uint64>, BUCKET_COUNT> _buckets = { };
+    std::atomic<uint64> _count{ 0 };
+    std::atomic<uint64> _total{ 0 };
+    std::atomic<uint64> _max{ 0 };
+};
+
+#endif // LATENCYHISTOGRAM_H__
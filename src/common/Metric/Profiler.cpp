@@ -0,0 +1,235 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+
+class Profiler::ThreadBuffer
+{
+public:
+    ThreadBuffer(uint32 id) : Id(id), _next(0), _wrapped(false) { }
+
+    void Push(ProfilerZoneRecord const& record, uint32 capacity)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_zones.size() != capacity)
+        {
+            _zones.assign(capacity, ProfilerZoneRecord());
+            _next = 0;
+            _wrapped = false;
+        }
+
+        _zones[_next] = record;
+        if (++_next == _zones.size())
+        {
+            _next = 0;
+            _wrapped = true;
+        }
+    }
+
+    // oldest first
+    std::vector<ProfilerZoneRecord> Copy()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::vector<ProfilerZoneRecord> zones;
+        if (_wrapped)
+            zones.insert(zones.end(), _zones.begin() + _next, _zones.end());
+        zones.insert(zones.end(), _zones.begin(), _zones.begin() + _next);
+        return zones;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _next = 0;
+        _wrapped = false;
+    }
+
+    void SetName(std::string const& name)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _name = name;
+    }
+
+    std::string GetName()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _name;
+    }
+
+    uint32 const Id;
+
+private:
+    std::mutex _lock;                   // only contended while a trace is written
+    std::vector<ProfilerZoneRecord> _zones;
+    std::size_t _next;
+    bool _wrapped;
+    std::string _name;
+};
+
+Profiler::Profiler() : _enabled(false), _zonesPerThread(DEFAULT_ZONES_PER_THREAD), _epoch(0) { }
+
+Profiler::~Profiler() = default;
+
+Profiler* Profiler::instance()
+{
+    static Profiler instance;
+    return &instance;
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    // the profiler shares ownership so zones of threads that already exited can still be written out
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(_threadsLock);
+        buffer = std::make_shared<ThreadBuffer>(uint32(_threads.size() + 1));
+        _threads.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+void Profiler::Start(uint32 zonesPerThread)
+{
+    {
+        std::lock_guard<std::mutex> lock(_threadsLock);
+        for (std::shared_ptr<ThreadBuffer> const& thread : _threads)
+            thread->Clear();
+    }
+
+    _zonesPerThread = std::max<uint32>(zonesPerThread, 1);
+    _epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    _enabled = true;
+}
+
+void Profiler::Stop()
+{
+    _enabled = false;
+}
+
+void Profiler::SetThreadName(std::string const& name)
+{
+    GetThreadBuffer().SetName(name);
+}
+
+void Profiler::Record(char const* name, uint32 arg, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    using namespace std::chrono;
+
+    ProfilerZoneRecord record;
+    record.Name = name;
+    record.Arg = arg;
+    record.Start = duration_cast<nanoseconds>(start.time_since_epoch()).count() - _epoch.load(std::memory_order_relaxed);
+    record.Duration = duration_cast<nanoseconds>(end - start).count();
+
+    // zones started before the profiler was (re)started
+    if (record.Start < 0)
+        return;
+
+    GetThreadBuffer().Push(record, _zonesPerThread.load(std::memory_order_relaxed));
+}
+
+namespace
+{
+    void WriteJsonString(std::ostream& stream, char const* str)
+    {
+        stream << '"';
+        for (; *str; ++str)
+        {
+            switch (*str)
+            {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                default:
+                    if (uint8(*str) >= 0x20)
+                        stream << *str;
+                    break;
+            }
+        }
+        stream << '"';
+    }
+
+    // trace timestamps are in microseconds
+    void WriteMicroseconds(std::ostream& stream, int64 ns)
+    {
+        stream << ns / 1000 << '.';
+        int64 fraction = ns % 1000;
+        if (fraction < 100)
+            stream << '0';
+        if (fraction < 10)
+            stream << '0';
+        stream << fraction;
+    }
+}
+
+void Profiler::WriteChromeTrace(std::ostream& stream)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    {
+        std::lock_guard<std::mutex> lock(_threadsLock);
+        threads = _threads;
+    }
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (std::shared_ptr<ThreadBuffer> const& thread : threads)
+    {
+        std::vector<ProfilerZoneRecord> zones = thread->Copy();
+        if (zones.empty())
+            continue;
+
+        std::string name = thread->GetName();
+        if (name.empty())
+            name = "Thread " + std::to_string(thread->Id);
+
+        if (!first)
+            stream << ',';
+        first = false;
+
+        stream << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread->Id << ",\"args\":{\"name\":";
+        WriteJsonString(stream, name.c_str());
+        stream << "}}";
+
+        for (ProfilerZoneRecord const& zone : zones)
+        {
+            stream << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->Id << ",\"name\":";
+            WriteJsonString(stream, zone.Name);
+            stream << ",\"ts\":";
+            WriteMicroseconds(stream, zone.Start);
+            stream << ",\"dur\":";
+            WriteMicroseconds(stream, zone.Duration);
+            if (zone.Arg)
+                stream << ",\"args\":{\"arg\":" << zone.Arg << '}';
+            stream << '}';
+        }
+    }
+    stream << "\n]}\n";
+}
+
+bool Profiler::DumpChromeTrace(std::string const& fileName)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+
+    WriteChromeTrace(file);
+    return bool(file);
+}
@@ -0,0 +1,123 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILER_H__
+#define PROFILER_H__
+
+#include "Define.h"
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfilerZoneRecord
+{
+    char const* Name;           // must have static storage duration
+    uint32 Arg;
+    int64 Start;                // nanoseconds since the profiler was started
+    int64 Duration;             // nanoseconds
+};
+
+/// Records timed zones of every thread into per-thread ring buffers while started and
+/// writes them out as a Chrome trace (chrome://tracing, ui.perfetto.dev) on demand.
+/// Zones are placed with FC_PROFILE_ZONE, which compiles to nothing unless built WITH_PROFILER.
+class FC_COMMON_API Profiler
+{
+public:
+    class ThreadBuffer;
+
+    static Profiler* instance();
+
+    static constexpr bool IsCompiledIn()
+    {
+#ifdef FC_PROFILER
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// Starts recording, every thread keeps its last zonesPerThread zones
+    void Start(uint32 zonesPerThread = DEFAULT_ZONES_PER_THREAD);
+    void Stop();
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    /// Names the calling thread in traces
+    void SetThreadName(std::string const& name);
+
+    void Record(char const* name, uint32 arg, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    void WriteChromeTrace(std::ostream& stream);
+    bool DumpChromeTrace(std::string const& fileName);
+
+    enum : uint32 { DEFAULT_ZONES_PER_THREAD = 0x10000 };
+
+private:
+    Profiler();
+    ~Profiler();
+
+    ThreadBuffer& GetThreadBuffer();
+
+    std::atomic<bool> _enabled;
+    std::atomic<uint32> _zonesPerThread;
+    std::atomic<int64> _epoch;
+    std::mutex _threadsLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _threads;
+};
+
+#define sProfiler Profiler::instance()
+
+class ProfilerZone
+{
+public:
+    explicit ProfilerZone(char const* name, uint32 arg = 0) : _name(name), _arg(arg), _enabled(sProfiler->IsEnabled())
+    {
+        if (_enabled)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    ~ProfilerZone()
+    {
+        if (_enabled)
+            sProfiler->Record(_name, _arg, _start, std::chrono::steady_clock::now());
+    }
+
+    ProfilerZone(ProfilerZone const&) = delete;
+    ProfilerZone& operator=(ProfilerZone const&) = delete;
+
+private:
+    char const* _name;
+    uint32 _arg;
+    bool _enabled;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#define FC_PROFILE_CONCAT_(a, b) a##b
+#define FC_PROFILE_CONCAT(a, b) FC_PROFILE_CONCAT_(a, b)
+
+#ifdef FC_PROFILER
+#define FC_PROFILE_ZONE(name) ProfilerZone FC_PROFILE_CONCAT(profilerZone, __LINE__)(name)
+#define FC_PROFILE_ZONE_ARG(name, arg) ProfilerZone FC_PROFILE_CONCAT(profilerZone, __LINE__)(name, arg)
+#else
+#define FC_PROFILE_ZONE(name) ((void)0)
+#define FC_PROFILE_ZONE_ARG(name, arg) ((void)0)
+#endif
+
+#endif // PROFILER_H__
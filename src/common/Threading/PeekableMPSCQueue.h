@@ -0,0 +1,117 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PeekableMPSCQueue_h__
+#define PeekableMPSCQueue_h__
+
+#include "MPSCQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+/// Lock free multi producer single consumer queue that supports the
+/// "peek, then keep or take" access pattern of LockedQueue::next(result, check).
+/// Any number of threads may Enqueue(); all other members belong to the consumer
+/// and must never be called from two threads at the same time.
+/// Items rejected by a checker or handed back through Requeue() are kept in a
+/// consumer owned buffer that is always drained before the lock free queue,
+/// so the original order is preserved.
+template<typename T>
+class PeekableMPSCQueue
+{
+public:
+    PeekableMPSCQueue() : _size(0) { }
+
+    ~PeekableMPSCQueue()
+    {
+        for (T* item : _pending)
+            delete item;
+    }
+
+    void Enqueue(T* input)
+    {
+        // count first so Size() can never observe more dequeues than enqueues
+        _size.fetch_add(1, std::memory_order_relaxed);
+        _queue.Enqueue(input);
+    }
+
+    bool Dequeue(T*& result)
+    {
+        T* front = Peek();
+        if (!front)
+            return false;
+
+        PopFront();
+        result = front;
+        return true;
+    }
+
+    /// Takes the front item only if check.Process(item) accepts it, otherwise it stays at the front
+    template<class Checker>
+    bool Dequeue(T*& result, Checker& check)
+    {
+        T* front = Peek();
+        if (!front || !check.Process(front))
+            return false;
+
+        PopFront();
+        result = front;
+        return true;
+    }
+
+    /// Puts previously dequeued items back in front of the queue, keeping their relative order
+    template<class Iterator>
+    void Requeue(Iterator begin, Iterator end)
+    {
+        _size.fetch_add(std::distance(begin, end), std::memory_order_relaxed);
+        _pending.insert(_pending.begin(), begin, end);
+    }
+
+    /// Approximate number of queued items, safe to call from any thread
+    std::size_t Size() const { return _size.load(std::memory_order_relaxed); }
+
+private:
+    T* Peek()
+    {
+        if (_pending.empty())
+        {
+            T* item;
+            if (!_queue.Dequeue(item))
+                return nullptr;
+
+            _pending.push_back(item);
+        }
+
+        return _pending.front();
+    }
+
+    void PopFront()
+    {
+        _pending.pop_front();
+        _size.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    MPSCQueue<T> _queue;
+    std::deque<T*> _pending;
+    std::atomic<std::size_t> _size;
+
+    PeekableMPSCQueue(PeekableMPSCQueue const&) = delete;
+    PeekableMPSCQueue& operator=(PeekableMPSCQueue const&) = delete;
+};
+
+#endif // PeekableMPSCQueue_h__
@@ -0,0 +1,223 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ConcurrentLookupTable_h__
+#define ConcurrentLookupTable_h__
+
+#include "Define.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// Open addressing (linear probing) hash table of pointers to objects that carry their
+/// own key, read through KeyOf. Find never locks and may run on any thread while one
+/// writer modifies the table; writers must be serialized by the owner.
+///
+/// Values are not owned and the key of a value must not change while it is in the
+/// table. Removed slots become tombstones and tables replaced by a rehash are retired
+/// rather than freed, so a lookup racing a writer never reads freed memory. Retired
+/// tables are kept until ReleaseRetiredTables is called or the table is destroyed.
+/// Rehashes that only purge tombstones keep the capacity, so inserts and removes
+/// retire a table every few operations and the owner must release them regularly at
+/// a point where no lookup can run. Use Reserve before bulk inserts to avoid growth.
+template<class Key, class T, class KeyOf, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class ConcurrentLookupTable
+{
+    struct Table
+    {
+        explicit Table(uint32 capacityLog2) : Shift(64 - capacityLog2), Mask((std::size_t(1) << capacityLog2) - 1),
+            Slots(new std::atomic<T*>[Mask + 1]), Used(0)
+        {
+            for (std::size_t i = 0; i <= Mask; ++i)
+                Slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        uint32 Shift;
+        std::size_t Mask;
+        std::unique_ptr<std::atomic<T*>[]> Slots;
+        std::size_t Used;                               // live values and tombstones
+    };
+
+public:
+    ConcurrentLookupTable() : _table(nullptr), _size(0)
+    {
+        Rehash(MIN_CAPACITY_LOG2);
+    }
+
+    ConcurrentLookupTable(ConcurrentLookupTable const&) = delete;
+    ConcurrentLookupTable& operator=(ConcurrentLookupTable const&) = delete;
+
+    /// Any thread
+    T* Find(Key const& key) const
+    {
+        Table const* table = _table.load(std::memory_order_acquire);
+        for (std::size_t i = GetSlot(*table, key), probes = 0; probes <= table->Mask; i = (i + 1) & table->Mask, ++probes)
+        {
+            T* value = table->Slots[i].load(std::memory_order_acquire);
+            if (!value)
+                return nullptr;
+
+            if (value != Tombstone() && KeyEqual()(KeyOf()(*value), key))
+                return value;
+        }
+
+        return nullptr;
+    }
+
+    /// Writer only. Replaces the value with the same key if there is one, returns false in that case
+    bool Insert(T* value)
+    {
+        Table* table = _table.load(std::memory_order_relaxed);
+        if ((table->Used + 1) * 4 > (table->Mask + 1) * 3)
+        {
+            Rehash(GetCapacityLog2(_size + 1));
+            table = _table.load(std::memory_order_relaxed);
+        }
+
+        Key const& key = KeyOf()(*value);
+        std::atomic<T*>* freeSlot = nullptr;
+        for (std::size_t i = GetSlot(*table, key);; i = (i + 1) & table->Mask)
+        {
+            T* current = table->Slots[i].load(std::memory_order_relaxed);
+            if (!current)
+            {
+                if (!freeSlot)
+                {
+                    freeSlot = &table->Slots[i];
+                    ++table->Used;
+                }
+                break;
+            }
+
+            if (current == Tombstone())
+            {
+                if (!freeSlot)
+                    freeSlot = &table->Slots[i];
+            }
+            else if (KeyEqual()(KeyOf()(*current), key))
+            {
+                table->Slots[i].store(value, std::memory_order_release);
+                return false;
+            }
+        }
+
+        freeSlot->store(value, std::memory_order_release);
+        ++_size;
+        return true;
+    }
+
+    /// Writer only. Returns the removed value, nullptr if there was none
+    T* Remove(Key const& key)
+    {
+        Table* table = _table.load(std::memory_order_relaxed);
+        for (std::size_t i = GetSlot(*table, key), probes = 0; probes <= table->Mask; i = (i + 1) & table->Mask, ++probes)
+        {
+            T* value = table->Slots[i].load(std::memory_order_relaxed);
+            if (!value)
+                return nullptr;
+
+            if (value != Tombstone() && KeyEqual()(KeyOf()(*value), key))
+            {
+                table->Slots[i].store(Tombstone(), std::memory_order_release);
+                --_size;
+                return value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /// Writer only. Sizes the table for count values without growing
+    void Reserve(std::size_t count)
+    {
+        uint32 capacityLog2 = GetCapacityLog2(count);
+        if (capacityLog2 > 64 - _table.load(std::memory_order_relaxed)->Shift)
+            Rehash(capacityLog2);
+    }
+
+    /// Writer only
+    void Clear()
+    {
+        std::unique_ptr<Table> table = std::make_unique<Table>(MIN_CAPACITY_LOG2);
+        _table.store(table.get(), std::memory_order_release);
+        _tables.push_back(std::move(table));
+        _size = 0;
+    }
+
+    /// Writer only, and only while no other thread can be inside Find
+    void ReleaseRetiredTables()
+    {
+        _tables.erase(_tables.begin(), _tables.end() - 1);
+    }
+
+    std::size_t Size() const { return _size; }
+
+    std::size_t GetCapacity() const { return _table.load(std::memory_order_relaxed)->Mask + 1; }
+
+    std::size_t GetRetiredTableCount() const { return _tables.size() - 1; }
+
+private:
+    static constexpr uint32 MIN_CAPACITY_LOG2 = 4;
+
+    static T* Tombstone() { return reinterpret_cast<T*>(uintptr_t(1)); }
+
+    // fibonacci hashing, std::hash of integers is usually the identity
+    static std::size_t GetSlot(Table const& table, Key const& key)
+    {
+        return std::size_t((uint64(Hash()(key)) * UI64LIT(0x9E3779B97F4A7C15)) >> table.Shift) & table.Mask;
+    }
+
+    // capacity keeping count values below half the slots
+    static uint32 GetCapacityLog2(std::size_t count)
+    {
+        uint32 capacityLog2 = MIN_CAPACITY_LOG2;
+        while ((std::size_t(1) << capacityLog2) < count * 2)
+            ++capacityLog2;
+        return capacityLog2;
+    }
+
+    void Rehash(uint32 capacityLog2)
+    {
+        std::unique_ptr<Table> table = std::make_unique<Table>(capacityLog2);
+        if (Table const* old = _table.load(std::memory_order_relaxed))
+        {
+            for (std::size_t i = 0; i <= old->Mask; ++i)
+            {
+                T* value = old->Slots[i].load(std::memory_order_relaxed);
+                if (!value || value == Tombstone())
+                    continue;
+
+                std::size_t slot = GetSlot(*table, KeyOf()(*value));
+                while (table->Slots[slot].load(std::memory_order_relaxed))
+                    slot = (slot + 1) & table->Mask;
+
+                table->Slots[slot].store(value, std::memory_order_relaxed);
+                ++table->Used;
+            }
+        }
+
+        _table.store(table.get(), std::memory_order_release);
+        _tables.push_back(std::move(table));
+    }
+
+    std::atomic<Table*> _table;
+    std::vector<std::unique_ptr<Table>> _tables;        // current table last, the rest retired
+    std::size_t _size;
+};
+
+#endif // ConcurrentLookupTable_h__
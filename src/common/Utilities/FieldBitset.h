@@ -0,0 +1,236 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FieldBitset_h__
+#define FieldBitset_h__
+
+#include "Define.h"
+#include "Errors.h"
+#include <algorithm>
+#include <memory>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FC_FIELD_BITSET_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FC_FIELD_BITSET_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// Bitset over the fields of an object, stored in 256 bit chunks so masks can be
+/// combined with wide AND/OR operations and walked over their set bits only.
+/// Operations taking other bitsets only touch the chunks of *this, the operands must be at least as large.
+class FieldBitset
+{
+public:
+    typedef uint64 BlockType;
+
+    enum : uint32
+    {
+        BLOCK_BITS      = 64,
+        CHUNK_BLOCKS    = 4,
+        CHUNK_BITS      = BLOCK_BITS * CHUNK_BLOCKS,
+        NPOS            = 0xFFFFFFFF
+    };
+
+    FieldBitset() : _chunkCount(0), _chunkCapacity(0), _fieldCount(0) { }
+    explicit FieldBitset(uint32 fieldCount) : FieldBitset() { Resize(fieldCount); }
+
+    FieldBitset(FieldBitset const& right) : FieldBitset()
+    {
+        Resize(right._fieldCount);
+        std::copy_n(right._chunks.get(), _chunkCount, _chunks.get());
+    }
+
+    FieldBitset& operator=(FieldBitset const& right)
+    {
+        if (this != &right)
+        {
+            Resize(right._fieldCount);
+            std::copy_n(right._chunks.get(), _chunkCount, _chunks.get());
+        }
+        return *this;
+    }
+
+    /// Resizes the set and clears all bits, storage is only reallocated when growing
+    void Resize(uint32 fieldCount)
+    {
+        uint32 chunkCount = (fieldCount + CHUNK_BITS - 1) / CHUNK_BITS;
+        if (chunkCount > _chunkCapacity)
+        {
+            _chunks = std::make_unique<Chunk[]>(chunkCount);
+            _chunkCapacity = chunkCount;
+        }
+        _chunkCount = chunkCount;
+        _fieldCount = fieldCount;
+        Clear();
+    }
+
+    uint32 GetFieldCount() const { return _fieldCount; }
+
+    void Set(uint32 index) { Block(index) |= BlockFlag(index); }
+    void Reset(uint32 index) { Block(index) &= ~BlockFlag(index); }
+    bool Test(uint32 index) const { return (Block(index) & BlockFlag(index)) != 0; }
+
+    void Clear()
+    {
+        if (_chunkCount)
+            std::fill_n(&_chunks[0].Blocks[0], _chunkCount * CHUNK_BLOCKS, BlockType(0));
+    }
+
+    /// *this |= other
+    void Or(FieldBitset const& other)
+    {
+        ASSERT(other._chunkCount >= _chunkCount);
+        for (uint32 i = 0; i < _chunkCount; ++i)
+        {
+            BlockType* dst = _chunks[i].Blocks;
+            BlockType const* src = other._chunks[i].Blocks;
+#if defined(FC_FIELD_BITSET_AVX2)
+            __m256i v = _mm256_or_si256(_mm256_load_si256(reinterpret_cast<__m256i const*>(dst)), _mm256_load_si256(reinterpret_cast<__m256i const*>(src)));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst), v);
+#elif defined(FC_FIELD_BITSET_SSE2)
+            __m128i lo = _mm_or_si128(_mm_load_si128(reinterpret_cast<__m128i const*>(dst)), _mm_load_si128(reinterpret_cast<__m128i const*>(src)));
+            __m128i hi = _mm_or_si128(_mm_load_si128(reinterpret_cast<__m128i const*>(dst + 2)), _mm_load_si128(reinterpret_cast<__m128i const*>(src + 2)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(dst), lo);
+            _mm_store_si128(reinterpret_cast<__m128i*>(dst + 2), hi);
+#else
+            for (uint32 b = 0; b < CHUNK_BLOCKS; ++b)
+                dst[b] |= src[b];
+#endif
+        }
+    }
+
+    /// *this = (a & b) | c
+    void AssignAndOr(FieldBitset const& a, FieldBitset const& b, FieldBitset const& c)
+    {
+        ASSERT(a._chunkCount >= _chunkCount && b._chunkCount >= _chunkCount && c._chunkCount >= _chunkCount);
+        for (uint32 i = 0; i < _chunkCount; ++i)
+        {
+            BlockType* dst = _chunks[i].Blocks;
+            BlockType const* pa = a._chunks[i].Blocks;
+            BlockType const* pb = b._chunks[i].Blocks;
+            BlockType const* pc = c._chunks[i].Blocks;
+#if defined(FC_FIELD_BITSET_AVX2)
+            __m256i v = _mm256_and_si256(_mm256_load_si256(reinterpret_cast<__m256i const*>(pa)), _mm256_load_si256(reinterpret_cast<__m256i const*>(pb)));
+            v = _mm256_or_si256(v, _mm256_load_si256(reinterpret_cast<__m256i const*>(pc)));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst), v);
+#elif defined(FC_FIELD_BITSET_SSE2)
+            for (uint32 b = 0; b < CHUNK_BLOCKS; b += 2)
+            {
+                __m128i v = _mm_and_si128(_mm_load_si128(reinterpret_cast<__m128i const*>(pa + b)), _mm_load_si128(reinterpret_cast<__m128i const*>(pb + b)));
+                v = _mm_or_si128(v, _mm_load_si128(reinterpret_cast<__m128i const*>(pc + b)));
+                _mm_store_si128(reinterpret_cast<__m128i*>(dst + b), v);
+            }
+#else
+            for (uint32 b = 0; b < CHUNK_BLOCKS; ++b)
+                dst[b] = (pa[b] & pb[b]) | pc[b];
+#endif
+        }
+    }
+
+    /// Sets exactly the bits of the non-zero values, count must not exceed the field count
+    void AssignNonZero(uint32 const* values, uint32 count)
+    {
+        ASSERT(count <= _fieldCount);
+        Clear();
+        if (!count)
+            return;
+
+        BlockType* blocks = &_chunks[0].Blocks[0];
+        uint32 index = 0;
+#if defined(FC_FIELD_BITSET_AVX2)
+        __m256i const zero = _mm256_setzero_si256();
+        for (; index + 8 <= count; index += 8)
+        {
+            __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + index)), zero);
+            BlockType nonZero = BlockType(~_mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xFF);
+            blocks[index / BLOCK_BITS] |= nonZero << (index % BLOCK_BITS);
+        }
+#elif defined(FC_FIELD_BITSET_SSE2)
+        __m128i const zero = _mm_setzero_si128();
+        for (; index + 4 <= count; index += 4)
+        {
+            __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(values + index)), zero);
+            BlockType nonZero = BlockType(~_mm_movemask_ps(_mm_castsi128_ps(eq)) & 0xF);
+            blocks[index / BLOCK_BITS] |= nonZero << (index % BLOCK_BITS);
+        }
+#endif
+        for (; index < count; ++index)
+            if (values[index])
+                Set(index);
+    }
+
+    /// Returns the first set bit at or after index, NPOS if there is none
+    uint32 FindNext(uint32 index) const
+    {
+        uint32 const blockCount = _chunkCount * CHUNK_BLOCKS;
+        uint32 block = index / BLOCK_BITS;
+        if (block >= blockCount)
+            return NPOS;
+
+        BlockType const* blocks = &_chunks[0].Blocks[0];
+        BlockType bits = blocks[block] & (~BlockType(0) << (index % BLOCK_BITS));
+        while (!bits)
+        {
+            if (++block >= blockCount)
+                return NPOS;
+
+            bits = blocks[block];
+        }
+
+        return block * BLOCK_BITS + CountTrailingZeros(bits);
+    }
+
+private:
+    struct alignas(32) Chunk
+    {
+        BlockType Blocks[CHUNK_BLOCKS];
+    };
+
+    BlockType& Block(uint32 index) { return _chunks[index / CHUNK_BITS].Blocks[(index % CHUNK_BITS) / BLOCK_BITS]; }
+    BlockType const& Block(uint32 index) const { return _chunks[index / CHUNK_BITS].Blocks[(index % CHUNK_BITS) / BLOCK_BITS]; }
+    static BlockType BlockFlag(uint32 index) { return BlockType(1) << (index % BLOCK_BITS); }
+
+    static uint32 CountTrailingZeros(BlockType bits)
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return uint32(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, uint32(bits)))
+            return uint32(index);
+        _BitScanForward(&index, uint32(bits >> 32));
+        return uint32(index) + 32;
+#else
+        return uint32(__builtin_ctzll(bits));
+#endif
+    }
+
+    std::unique_ptr<Chunk[]> _chunks;
+    uint32 _chunkCount;
+    uint32 _chunkCapacity;
+    uint32 _fieldCount;
+};
+
+#endif // FieldBitset_h__
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RatingBucketQueue_h__
+#define RatingBucketQueue_h__
+
+#include "Define.h"
+#include "Errors.h"
+#include "Timer.h"
+#include <list>
+#include <map>
+#include <unordered_map>
+
+/// Queue of values with a rating, grouped into buckets of bucketWidth rating points.
+/// Within a bucket values keep the order they were added in, so finding the longest
+/// waiting value of a rating range only looks at the buckets overlapping that range.
+template<class T>
+class RatingBucketQueue
+{
+    struct Entry
+    {
+        T* Value;
+        uint32 Rating;
+        uint32 JoinTime;
+        uint64 Sequence;
+    };
+
+    typedef std::list<Entry> Bucket;
+    typedef std::map<uint32, Bucket> BucketMap;
+
+    struct Position
+    {
+        typename BucketMap::iterator BucketItr;
+        typename Bucket::iterator EntryItr;
+    };
+
+public:
+    explicit RatingBucketQueue(uint32 bucketWidth = 64) : _bucketWidth(bucketWidth ? bucketWidth : 1), _nextSequence(0) { }
+
+    RatingBucketQueue(RatingBucketQueue const&) = delete;
+    RatingBucketQueue& operator=(RatingBucketQueue const&) = delete;
+
+    /// Values added later are considered to have waited shorter, regardless of joinTime
+    void Add(T* value, uint32 rating, uint32 joinTime)
+    {
+        ASSERT(!_positions.count(value));
+
+        typename BucketMap::iterator bucketItr = _buckets.emplace(rating / _bucketWidth, Bucket()).first;
+        typename Bucket::iterator entryItr = bucketItr->second.insert(bucketItr->second.end(), { value, rating, joinTime, _nextSequence++ });
+        _positions[value] = { bucketItr, entryItr };
+    }
+
+    bool Remove(T* value)
+    {
+        auto itr = _positions.find(value);
+        if (itr == _positions.end())
+            return false;
+
+        Position position = itr->second;
+        _positions.erase(itr);
+
+        position.BucketItr->second.erase(position.EntryItr);
+        if (position.BucketItr->second.empty())
+            _buckets.erase(position.BucketItr);
+        return true;
+    }
+
+    bool Contains(T* value) const { return _positions.count(value) != 0; }
+    bool Empty() const { return _positions.empty(); }
+    std::size_t Size() const { return _positions.size(); }
+
+    void Clear()
+    {
+        _positions.clear();
+        _buckets.clear();
+    }
+
+    /// Returns the longest waiting value that is either rated within [minRating, maxRating]
+    /// or has waited more than maxWaitTime milliseconds at now, ignoring values for which
+    /// skip returns true. Join times are getMSTime style and may wrap around.
+    /// Returns nullptr if there is no such value.
+    template<class Skip>
+    T* FindOldest(uint32 minRating, uint32 maxRating, uint32 now, uint32 maxWaitTime, Skip skip) const
+    {
+        // any value old enough to ignore its rating waited longer than every value in the range,
+        // so if the longest waiting value overall isn't old enough none is
+        Entry const* oldest = nullptr;
+        for (auto const& bucket : _buckets)
+            if (Entry const* entry = FindFirst(bucket.second, [&skip](Entry const& e) { return !skip(e.Value); }))
+                if (!oldest || entry->Sequence < oldest->Sequence)
+                    oldest = entry;
+
+        if (!oldest)
+            return nullptr;
+
+        if (getMSTimeDiff(oldest->JoinTime, now) > maxWaitTime)
+            return oldest->Value;
+
+        oldest = nullptr;
+        if (minRating > maxRating)
+            return nullptr;
+
+        for (auto itr = _buckets.lower_bound(minRating / _bucketWidth); itr != _buckets.end() && itr->first <= maxRating / _bucketWidth; ++itr)
+        {
+            Entry const* entry = FindFirst(itr->second, [&](Entry const& e)
+            {
+                return e.Rating >= minRating && e.Rating <= maxRating && !skip(e.Value);
+            });
+
+            if (entry && (!oldest || entry->Sequence < oldest->Sequence))
+                oldest = entry;
+        }
+
+        return oldest ? oldest->Value : nullptr;
+    }
+
+    T* FindOldest(uint32 minRating, uint32 maxRating, uint32 now, uint32 maxWaitTime) const
+    {
+        return FindOldest(minRating, maxRating, now, maxWaitTime, [](T*) { return false; });
+    }
+
+private:
+    template<class Pred>
+    static Entry const* FindFirst(Bucket const& bucket, Pred pred)
+    {
+        for (Entry const& entry : bucket)
+            if (pred(entry))
+                return &entry;
+        return nullptr;
+    }
+
+    uint32 _bucketWidth;
+    uint64 _nextSequence;
+    BucketMap _buckets;
+    std::unordered_map<T*, Position> _positions;
+};
+
+#endif // RatingBucketQueue_h__
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ShardedHashMap_h__
+#define ShardedHashMap_h__
+
+#include "Define.h"
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/// Hash map split into ShardCount independently locked maps. A lookup only takes
+/// the shared lock of the shard its key hashes to, so concurrent lookups of
+/// different keys rarely touch the same lock and never wait on a writer
+/// updating another shard.
+template<class Key, class Value, std::size_t ShardCount = 64, class Hash = std::hash<Key>>
+class ShardedHashMap
+{
+    static_assert(ShardCount && !(ShardCount & (ShardCount - 1)), "ShardCount must be a power of two");
+
+    // padded to a cache line so readers of neighbouring shards do not share one
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex Lock;
+        std::unordered_map<Key, Value, Hash> Map;
+    };
+
+public:
+    ShardedHashMap() = default;
+    ShardedHashMap(ShardedHashMap const&) = delete;
+    ShardedHashMap& operator=(ShardedHashMap const&) = delete;
+
+    void Insert(Key const& key, Value const& value)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        shard.Map[key] = value;
+    }
+
+    bool Remove(Key const& key)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> lock(shard.Lock);
+        return shard.Map.erase(key) != 0;
+    }
+
+    /// Returns the value stored for key, or defaultValue if there is none
+    Value Find(Key const& key, Value const& defaultValue = Value()) const
+    {
+        Shard const& shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> lock(shard.Lock);
+        auto itr = shard.Map.find(key);
+        return itr != shard.Map.end() ? itr->second : defaultValue;
+    }
+
+    std::size_t Size() const
+    {
+        std::size_t size = 0;
+        for (Shard const& shard : _shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.Lock);
+            size += shard.Map.size();
+        }
+        return size;
+    }
+
+    void Clear()
+    {
+        for (Shard& shard : _shards)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.Lock);
+            shard.Map.clear();
+        }
+    }
+
+    static std::size_t GetShardIndex(Key const& key)
+    {
+        // std::hash of integers is usually the identity, spread sequential keys over all shards
+        uint64 hash = uint64(Hash()(key)) * UI64LIT(0x9E3779B97F4A7C15);
+        return std::size_t(hash >> 32) & (ShardCount - 1);
+    }
+
+private:
+    Shard& GetShard(Key const& key) { return _shards[GetShardIndex(key)]; }
+    Shard const& GetShard(Key const& key) const { return _shards[GetShardIndex(key)]; }
+
+    std::array<Shard, ShardCount> _shards;
+};
+
+#endif // ShardedHashMap_h__
@@ -46,6 +46,8 @@ using WorldDatabasePreparedStatement = PreparedStatement<WorldDatabaseConnection
 
 class PreparedResultSet;
 using PreparedQueryResult = std::shared_ptr<PreparedResultSet>;
+class PreparedResultCursor;
+using PreparedQueryCursor = std::unique_ptr<PreparedResultCursor>;
 using PreparedQueryResultFuture = std::future<PreparedQueryResult>;
 using PreparedQueryResultPromise = std::promise<PreparedQueryResult>;
 
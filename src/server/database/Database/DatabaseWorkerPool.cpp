@@ -202,6 +202,29 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
     return PreparedQueryResult(ret);
 }
 
+template <class T>
+PreparedQueryCursor DatabaseWorkerPool<T>::StreamQuery(PreparedStatement<T>* stmt)
+{
+    auto connection = GetFreeConnection();
+    PreparedResultCursor* ret = connection->StreamQuery(stmt);
+
+    //! Delete proxy-class. Not needed anymore
+    delete stmt;
+
+    //! The cursor unlocks the connection once it is done with it
+    if (!ret)
+    {
+        connection->Unlock();
+        return nullptr;
+    }
+
+    PreparedQueryCursor cursor(ret);
+    if (!cursor->NextRow())
+        return nullptr;
+
+    return cursor;
+}
+
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 {
@@ -223,11 +246,21 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, bool spreadAcrossConnections /*= false*/)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
+    // splitting only pays off when each connection gets a few round trips to save
+    static constexpr size_t MinStatementsPerPart = 4;
+
+    size_t partCount = 1;
+    if (spreadAcrossConnections)
+        partCount = std::max<size_t>(std::min<size_t>(_async_threads, holder->GetSize() / MinStatementsPerPart), 1);
+
+    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, partCount);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultHolderFuture result = task->GetFuture();
+    for (size_t part = 1; part < partCount; ++part)
+        Enqueue(task->CreatePart(part));
+
     Enqueue(task);
     return { std::move(holder), std::move(result) };
 }
@@ -143,6 +143,13 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+        //! Directly executes a query in prepared format and streams its rows instead of buffering the whole result.
+        //! The returned cursor is positioned on the first row, or null if there are no rows.
+        //! Meant for bulk loads: the synchronous connection stays locked until the cursor is destroyed, so do not
+        //! run other synchronous queries on this database from the same thread meanwhile.
+        //! Statement must be prepared with CONNECTION_SYNCH flag.
+        PreparedQueryCursor StreamQuery(PreparedStatement<T>* stmt);
+
         /**
             Asynchronous query (with resultset) methods.
         */
@@ -160,7 +167,9 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        //! With spreadAcrossConnections the statements are split between the async connections and executed
+        //! concurrently, only use it for holders whose statements do not depend on each other.
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, bool spreadAcrossConnections = false);
 
         /**
             Transaction context methods.
@@ -206,6 +215,9 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Number of synchronous connections, i.e. how many synchronous queries can run at the same time.
+        uint8 GetSynchConnectionCount() const { return _synch_threads; }
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -81,6 +81,7 @@ class FC_DATABASE_API Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class PreparedResultCursor;
 
     public:
         Field();
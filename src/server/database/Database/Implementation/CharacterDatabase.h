@@ -51,6 +51,8 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_FREE_NAME,
     CHAR_SEL_CHAR_ZONE,
     CHAR_SEL_CHARACTER_NAME_DATA,
+    CHAR_SEL_CHARACTER_CACHE,
+    CHAR_SEL_CHARACTER_GUID_RANGE,
     CHAR_SEL_CHAR_POSITION_XYZ,
     CHAR_SEL_CHAR_POSITION,
 
@@ -93,6 +95,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_CHARACTER_ACTIONS,
     CHAR_SEL_CHARACTER_ACTIONS_SPEC,
     CHAR_SEL_MAIL_COUNT,
+    CHAR_SEL_MAIL_SUMMARY,
     CHAR_SEL_CHARACTER_SOCIALLIST,
     CHAR_SEL_CHARACTER_HOMEBIND,
     CHAR_SEL_CHARACTER_SPELLCOOLDOWNS,
@@ -397,6 +400,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_CHAR_SOCIAL,
     CHAR_SEL_CHAR_OLD_CHARS,
     CHAR_SEL_MAIL,
+    CHAR_SEL_MAIL_NEXT_TIME,
     CHAR_SEL_CHAR_PLAYERBYTES2,
     CHAR_DEL_CHAR_AURA_FROZEN,
     CHAR_SEL_CHAR_INVENTORY_COUNT_ITEM,
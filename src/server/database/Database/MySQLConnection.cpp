@@ -506,6 +506,21 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     return new PreparedResultSet(stmt->m_stmt->GetSTMT(), result, rowCount, fieldCount);
 }
 
+PreparedResultCursor* MySQLConnection::StreamQuery(PreparedStatementBase* stmt)
+{
+    MySQLResult* result = nullptr;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if (!_Query(stmt, &result, &rowCount, &fieldCount))
+        return nullptr;
+
+    if (!result)
+        return nullptr;
+
+    return new PreparedResultCursor(this, stmt->m_stmt->GetSTMT(), result, fieldCount);
+}
+
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
 {
     switch (errNo)
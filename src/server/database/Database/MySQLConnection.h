@@ -55,6 +55,7 @@ class FC_DATABASE_API MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
     friend class PingOperation;
+    friend class PreparedResultCursor;
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
@@ -70,6 +71,8 @@ class FC_DATABASE_API MySQLConnection
         bool Execute(PreparedStatementBase* stmt);
         ResultSet* Query(char const* sql);
         PreparedResultSet* Query(PreparedStatementBase* stmt);
+        //! Executes the statement without buffering its result, the connection stays locked until the cursor is destroyed
+        PreparedResultCursor* StreamQuery(PreparedStatementBase* stmt);
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
         bool _Query(PreparedStatementBase* stmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
 
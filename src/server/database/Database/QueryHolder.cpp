@@ -21,6 +21,7 @@
 #include "MySQLConnection.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include <algorithm>
 
 bool SQLQueryHolderBase::SetPreparedQueryImpl(size_t index, PreparedStatementBase* stmt)
 {
@@ -72,16 +73,36 @@ void SQLQueryHolderBase::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+SQLQueryHolderTask::SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, size_t partCount /*= 1*/)
+    : m_holder(std::move(holder)), m_result(std::make_shared<QueryResultHolderPromise>()),
+    m_pendingParts(std::make_shared<std::atomic<size_t>>(std::max<size_t>(partCount, 1))), m_part(0), m_partCount(std::max<size_t>(partCount, 1))
+{
+}
+
+SQLQueryHolderTask::SQLQueryHolderTask(SQLQueryHolderTask const& first, size_t part)
+    : m_holder(first.m_holder), m_result(first.m_result), m_pendingParts(first.m_pendingParts), m_part(part), m_partCount(first.m_partCount)
+{
+}
+
 SQLQueryHolderTask::~SQLQueryHolderTask() = default;
 
+SQLQueryHolderTask* SQLQueryHolderTask::CreatePart(size_t part) const
+{
+    ASSERT(part > 0 && part < m_partCount, "Query holder part " SZFMTD " out of range, holder is split in " SZFMTD " parts", part, m_partCount);
+    return new SQLQueryHolderTask(*this, part);
+}
+
 bool SQLQueryHolderTask::Execute()
 {
-    /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < m_holder->m_queries.size(); ++i)
+    /// execute this part's queries in the holder and pass the results, parts never share an index
+    for (size_t i = m_part; i < m_holder->m_queries.size(); i += m_partCount)
         if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
             m_holder->SetPreparedResult(i, m_conn->Query(stmt));
 
-    m_result.set_value();
+    /// the last part to finish has seen the results of all others
+    if (m_pendingParts->fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_result->set_value();
+
     return true;
 }
 
@@ -19,6 +19,7 @@
 #define _QUERYHOLDER_H
 
 #include "SQLOperation.h"
+#include <atomic>
 #include <vector>
 
 class FC_DATABASE_API SQLQueryHolderBase
@@ -31,6 +32,7 @@ class FC_DATABASE_API SQLQueryHolderBase
         SQLQueryHolderBase() = default;
         virtual ~SQLQueryHolderBase();
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         PreparedQueryResult GetPreparedResult(size_t index) const;
         void SetPreparedResult(size_t index, PreparedResultSet* result);
 
@@ -48,20 +50,30 @@ public:
     }
 };
 
+//! Executes the statements of a holder. A holder can be split in several parts executed by
+//! different async connections at once; part N runs every Nth statement and the last part
+//! to finish completes the future.
 class FC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
     private:
         std::shared_ptr<SQLQueryHolderBase> m_holder;
-        QueryResultHolderPromise m_result;
+        std::shared_ptr<QueryResultHolderPromise> m_result;
+        std::shared_ptr<std::atomic<size_t>> m_pendingParts;
+        size_t m_part;
+        size_t m_partCount;
+
+        SQLQueryHolderTask(SQLQueryHolderTask const& first, size_t part);
 
     public:
-        explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
-            : m_holder(std::move(holder)) { }
+        explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, size_t partCount = 1);
 
         ~SQLQueryHolderTask();
 
+        //! Creates the task executing the given part (1 to partCount - 1), this task executes part 0
+        SQLQueryHolderTask* CreatePart(size_t part) const;
+
         bool Execute() override;
-        QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
+        QueryResultHolderFuture GetFuture() { return m_result->get_future(); }
 };
 
 class FC_DATABASE_API SQLQueryHolderCallback
@@ -19,8 +19,10 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "MySQLConnection.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include <algorithm>
 
 namespace
 {
@@ -152,6 +154,34 @@ static char const* FieldTypeToString(enum_field_types type)
     }
 }
 
+bool IsVariableLengthType(enum_field_types type)
+{
+    switch (type)
+    {
+        case MYSQL_TYPE_TINY_BLOB:
+        case MYSQL_TYPE_MEDIUM_BLOB:
+        case MYSQL_TYPE_LONG_BLOB:
+        case MYSQL_TYPE_BLOB:
+        case MYSQL_TYPE_STRING:
+        case MYSQL_TYPE_VAR_STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// max_length is only known after mysql_stmt_store_result, streamed columns start from the declared
+// length and grow on the first row that does not fit
+uint32 StreamSizeForType(MYSQL_FIELD* field)
+{
+    static constexpr unsigned long InitialVariableLength = 256;
+
+    if (IsVariableLengthType(field->type))
+        return std::min(field->length, InitialVariableLength) + 1;
+
+    return SizeForType(field);
+}
+
 void InitializeDatabaseFieldMetadata(QueryResultFieldMetadata* meta, MySQLField const* field, uint32 fieldIndex)
 {
     meta->TableName = field->org_table;
@@ -416,3 +446,174 @@ void PreparedResultSet::CleanUp()
         m_rBind = nullptr;
     }
 }
+
+PreparedResultCursor::PreparedResultCursor(MySQLConnection* connection, MySQLStmt* stmt, MySQLResult* result, uint32 fieldCount) :
+m_fetchedRowCount(0),
+m_fieldCount(fieldCount),
+m_rBind(nullptr),
+m_stmt(stmt),
+m_metadataResult(result),
+m_connection(connection)
+{
+    if (m_stmt->bind_result_done)
+    {
+        delete[] m_stmt->bind->length;
+        delete[] m_stmt->bind->is_null;
+    }
+
+    m_rBind = new MySQLBind[m_fieldCount];
+
+    //- same ownership as in PreparedResultSet, these are freed by the next result bound to this statement
+    MySQLBool* isNull = new MySQLBool[m_fieldCount];
+    unsigned long* length = new unsigned long[m_fieldCount];
+
+    memset(isNull, 0, sizeof(MySQLBool) * m_fieldCount);
+    memset(m_rBind, 0, sizeof(MySQLBind) * m_fieldCount);
+    memset(length, 0, sizeof(unsigned long) * m_fieldCount);
+
+    MySQLField* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(m_metadataResult));
+    m_fieldMetadata.resize(m_fieldCount);
+    m_row.resize(m_fieldCount);
+    m_buffers.resize(m_fieldCount);
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        InitializeDatabaseFieldMetadata(&m_fieldMetadata[i], &field[i], i);
+        m_row[i].SetMetadata(&m_fieldMetadata[i]);
+        m_buffers[i].resize(StreamSizeForType(&field[i]));
+
+        m_rBind[i].buffer_type = field[i].type;
+        m_rBind[i].length = &length[i];
+        m_rBind[i].is_null = &isNull[i];
+        m_rBind[i].error = nullptr;
+        m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
+    }
+
+    if (!BindResult())
+    {
+        // the statement never took the arrays, nobody else will free them
+        delete[] isNull;
+        delete[] length;
+        Finish();
+    }
+}
+
+PreparedResultCursor::~PreparedResultCursor()
+{
+    Finish();
+    delete[] m_rBind;
+}
+
+bool PreparedResultCursor::BindResult()
+{
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        m_rBind[i].buffer = m_buffers[i].data();
+        m_rBind[i].buffer_length = m_buffers[i].size();
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_rBind))
+    {
+        LOG_WARN("sql.sql", "%s:mysql_stmt_bind_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        return false;
+    }
+
+    return true;
+}
+
+bool PreparedResultCursor::FetchTruncatedColumns()
+{
+    bool resized = false;
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        unsigned long fetchedLength = *m_rBind[i].length;
+        if (*m_rBind[i].is_null || !IsVariableLengthType(m_rBind[i].buffer_type) || fetchedLength < m_buffers[i].size())
+            continue;
+
+        // keep room for the terminator GetCString relies on
+        m_buffers[i].resize(fetchedLength + 1);
+
+        MySQLBind bind = m_rBind[i];
+        bind.buffer = m_buffers[i].data();
+        bind.buffer_length = m_buffers[i].size();
+        if (mysql_stmt_fetch_column(m_stmt, &bind, i, 0))
+        {
+            LOG_WARN("sql.sql", "%s:mysql_stmt_fetch_column, cannot fetch truncated column %u. Error: %s", __FUNCTION__, i, mysql_stmt_error(m_stmt));
+            return false;
+        }
+
+        resized = true;
+    }
+
+    // later rows of the same size no longer need a second round
+    return !resized || BindResult();
+}
+
+bool PreparedResultCursor::NextRow()
+{
+    if (!m_stmt)
+        return false;
+
+    int retval = mysql_stmt_fetch(m_stmt);
+    if (retval == MYSQL_DATA_TRUNCATED)
+    {
+        if (!FetchTruncatedColumns())
+        {
+            Finish();
+            return false;
+        }
+    }
+    else if (retval != 0)
+    {
+        if (retval != MYSQL_NO_DATA)
+            LOG_WARN("sql.sql", "%s:mysql_stmt_fetch, cannot fetch row " UI64FMTD ". Error: %s", __FUNCTION__, m_fetchedRowCount, mysql_stmt_error(m_stmt));
+
+        Finish();
+        return false;
+    }
+
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+    {
+        unsigned long fetchedLength = *m_rBind[i].length;
+        if (*m_rBind[i].is_null)
+        {
+            m_row[i].SetByteValue(nullptr, fetchedLength);
+            continue;
+        }
+
+        char* buffer = m_buffers[i].data();
+        if (IsVariableLengthType(m_rBind[i].buffer_type) && fetchedLength < m_buffers[i].size())
+            buffer[fetchedLength] = '\0';
+
+        m_row[i].SetByteValue(buffer, fetchedLength);
+    }
+
+    ++m_fetchedRowCount;
+    return true;
+}
+
+Field* PreparedResultCursor::Fetch() const
+{
+    ASSERT(m_fetchedRowCount);
+    return const_cast<Field*>(m_row.data());
+}
+
+Field const& PreparedResultCursor::operator[](std::size_t index) const
+{
+    ASSERT(m_fetchedRowCount);
+    ASSERT(index < m_fieldCount);
+    return m_row[index];
+}
+
+void PreparedResultCursor::Finish()
+{
+    if (!m_stmt)
+        return;
+
+    /// discards the rows not fetched yet, the connection is usable again afterwards
+    mysql_stmt_free_result(m_stmt);
+    mysql_free_result(m_metadataResult);
+    m_connection->Unlock();
+
+    m_stmt = nullptr;
+    m_metadataResult = nullptr;
+}
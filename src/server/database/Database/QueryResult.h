@@ -22,6 +22,8 @@
 #include "DatabaseEnvFwd.h"
 #include <vector>
 
+class MySQLConnection;
+
 class FC_DATABASE_API ResultSet
 {
     public:
@@ -82,4 +84,40 @@ class FC_DATABASE_API PreparedResultSet
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
 };
 
+/// Streams the rows of a prepared statement from the server instead of buffering the whole result first.
+/// Only the current row is kept; its fields point into buffers reused for the next row, so values must be
+/// read before calling NextRow. The connection that ran the statement stays locked until the cursor is
+/// destroyed, either after the last row or when it goes out of scope.
+class FC_DATABASE_API PreparedResultCursor
+{
+    public:
+        PreparedResultCursor(MySQLConnection* connection, MySQLStmt* stmt, MySQLResult* result, uint32 fieldCount);
+        ~PreparedResultCursor();
+
+        bool NextRow();
+        uint64 GetFetchedRowCount() const { return m_fetchedRowCount; }
+        uint32 GetFieldCount() const { return m_fieldCount; }
+
+        Field* Fetch() const;
+        Field const& operator[](std::size_t index) const;
+
+    private:
+        std::vector<QueryResultFieldMetadata> m_fieldMetadata;
+        std::vector<Field> m_row;
+        std::vector<std::vector<char>> m_buffers;
+        uint64 m_fetchedRowCount;
+        uint32 m_fieldCount;
+        MySQLBind* m_rBind;
+        MySQLStmt* m_stmt;
+        MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        MySQLConnection* m_connection;
+
+        bool BindResult();
+        bool FetchTruncatedColumns();
+        void Finish();
+
+        PreparedResultCursor(PreparedResultCursor const& right) = delete;
+        PreparedResultCursor& operator=(PreparedResultCursor const& right) = delete;
+};
+
 #endif
@@ -228,6 +228,9 @@ class FC_GAME_API CreatureAI : public UnitAI
 
         virtual bool CanSeeAlways(WorldObject const* /*obj*/) { return false; }
 
+        // Whether the AI runs timers that must advance every map tick, keeps the creature in the active update tier
+        virtual bool HasScheduledEvents() const { return false; }
+
         // Called when a player is charmed by the creature
         // If a PlayerAI* is returned, that AI is placed on the player instead of the default charm AI
         // Object destruction is handled by Unit::RemoveCharmedBy
@@ -60,6 +60,11 @@ void SmartAI::UpdateDespawn(uint32 diff)
     } else _despawnTime -= diff;
 }
 
+bool SmartAI::HasScheduledEvents() const
+{
+    return mScript.HasScheduledEvents() || _escortState != SMART_ESCORT_NONE || _followGuid || _hasConditions || (_despawnState > 1 && _despawnState <= 3);
+}
+
 void SmartAI::StartPath(bool run/* = false*/, uint32 pathId/* = 0*/, bool repeat/* = false*/, Unit* invoker/* = nullptr*/, uint32 nodeId/* = 1*/)
 {
     if (HasEscortState(SMART_ESCORT_ESCORTING))
@@ -77,6 +77,8 @@ class FC_GAME_API SmartAI : public CreatureAI
         void SetScript9(SmartScriptHolder& e, uint32 entry, Unit* invoker);
         SmartScript* GetScript() { return &mScript; }
 
+        bool HasScheduledEvents() const override;
+
         // Called when creature is spawned or respawned
         void JustAppeared() override;
 
@@ -3971,6 +3971,11 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
 }
 
+bool SmartScript::HasScheduledEvents() const
+{
+    return !mEvents.empty() || !mInstallEvents.empty() || !mStoredEvents.empty() || !mTimedActionList.empty() || mUseTextTimer;
+}
+
 void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEntry const* at, Quest const* quest)
 {
     if (e.empty())
@@ -63,6 +63,8 @@ class FC_GAME_API SmartScript
         static bool IsGameObject(WorldObject* obj);
 
         void OnUpdate(const uint32 diff);
+        // Whether any event, stored event, timed action list or text timer is counted down by OnUpdate
+        bool HasScheduledEvents() const;
         void OnMoveInLineOfSight(Unit* who);
 
         Unit* DoSelectLowestHpFriendly(float range, uint32 MinHPDiff);
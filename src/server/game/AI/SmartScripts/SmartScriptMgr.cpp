@@ -46,7 +46,7 @@ void SmartWaypointMgr::LoadFromDB()
     _waypointStore.clear();
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMARTAI_WP);
-    PreparedQueryResult result = WorldDatabase.Query(stmt);
+    PreparedQueryCursor result = WorldDatabase.StreamQuery(stmt);
 
     if (!result)
     {
@@ -124,7 +124,7 @@ void SmartAIMgr::LoadSmartAIFromDB()
         mEventMap[i].clear();  //Drop Existing SmartAI List
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMART_SCRIPTS);
-    PreparedQueryResult result = WorldDatabase.Query(stmt);
+    PreparedQueryCursor result = WorldDatabase.StreamQuery(stmt);
 
     if (!result)
     {
@@ -37,6 +37,7 @@
 #include "Mail.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "ReputationMgr.h"
@@ -440,6 +441,7 @@ void AchievementMgr<T>::RemoveCriteriaProgress(AchievementCriteriaEntry const* e
     SendPacket(&data);
 
     m_criteriaProgress.erase(criteriaProgress);
+    SetCompletedCriteriaCached(entry->ID, false);
 }
 
 template<>
@@ -477,6 +479,7 @@ void AchievementMgr<Guild>::RemoveCriteriaProgress(AchievementCriteriaEntry cons
     SendPacket(&data);
 
     m_criteriaProgress.erase(criteriaProgress);
+    SetCompletedCriteriaCached(entry->ID, false);
 }
 
 template<class T>
@@ -720,6 +723,8 @@ void AchievementMgr<Player>::LoadFromDB(PreparedQueryResult achievementResult, P
             progress.counter = counter;
             progress.date    = date;
             progress.changed = false;
+
+            RefreshCompletedCriteriaCache(criteria, sAchievementMgr->GetAchievement(criteria->ReferredAchievement));
         }
         while (criteriaResult->NextRow());
     }
@@ -783,6 +788,8 @@ void AchievementMgr<Guild>::LoadFromDB(PreparedQueryResult achievementResult, Pr
             progress.date    = date;
             progress.CompletedGUID = ObjectGuid(HighGuid::Player, guid);
             progress.changed = false;
+
+            RefreshCompletedCriteriaCache(criteria, sAchievementMgr->GetAchievement(criteria->ReferredAchievement));
         } while (criteriaResult->NextRow());
     }
 }
@@ -812,6 +819,7 @@ void AchievementMgr<Player>::Reset()
     m_completedAchievements.clear();
     _achievementPoints = 0;
     m_criteriaProgress.clear();
+    m_completedCriteria.clear();
     DeleteFromDB(GetOwner()->GetGUID());
 
     // re-fill data
@@ -1154,10 +1162,20 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes type,
     if (IsGuild<T>() && !sWorld->getBoolConfig(CONFIG_GUILD_LEVELING_ENABLED))
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type, miscValue1, IsGuild<T>());
+    uint32 lookupValue = AchievementGlobalMgr::GetAchievementCriteriaLookupValue(type, miscValue1, miscValue2, miscValue3);
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type, lookupValue, IsGuild<T>());
+    uint32 evaluated = 0;
+    uint32 updated = 0;
     for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
     {
         AchievementCriteriaEntry const* achievementCriteria = (*i);
+
+        // completed criteria can only progress again after their progress was reset
+        if (IsCompletedCriteriaCached(achievementCriteria->ID))
+            continue;
+
+        ++evaluated;
+
         AchievementEntry const* achievement = sAchievementMgr->GetAchievement(achievementCriteria->ReferredAchievement);
         if (!achievement)
         {
@@ -1182,6 +1200,8 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes type,
                 break;
         }
 
+        ++updated;
+
         switch (type)
         {
             // std. case: increment at 1
@@ -1512,6 +1532,38 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes type,
                 if (IsCompletedAchievement(*itr))
                     CompletedAchievement(*itr, referencePlayer);
     }
+
+    sAchievementMgr->RecordCriteriaUpdate(type, evaluated, updated);
+}
+
+template<class T>
+bool AchievementMgr<T>::IsCompletedCriteriaCached(uint32 criteriaId) const
+{
+    return criteriaId < m_completedCriteria.size() && m_completedCriteria[criteriaId];
+}
+
+template<class T>
+void AchievementMgr<T>::SetCompletedCriteriaCached(uint32 criteriaId, bool completed)
+{
+    if (criteriaId >= m_completedCriteria.size())
+    {
+        if (!completed)
+            return;
+
+        m_completedCriteria.resize(sAchievementCriteriaStore.GetNumRows(), false);
+        if (criteriaId >= m_completedCriteria.size())
+            return;
+    }
+
+    m_completedCriteria[criteriaId] = completed;
+}
+
+template<class T>
+void AchievementMgr<T>::RefreshCompletedCriteriaCache(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement)
+{
+    // realm first criteria stop being completed when someone else gets the achievement, never cache them
+    bool cacheable = achievement && !(achievement->Flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL | ACHIEVEMENT_FLAG_REALM_FIRST_GUILD));
+    SetCompletedCriteriaCached(criteria->ID, cacheable && IsCompletedCriteria(criteria, achievement));
 }
 
 template<class T>
@@ -1793,6 +1845,7 @@ void AchievementMgr<T>::SetCriteriaProgress(AchievementCriteriaEntry const* entr
     AchievementEntry const* achievement = sAchievementMgr->GetAchievement(entry->ReferredAchievement);
     uint32 timeElapsed = 0;
     bool criteriaComplete = IsCompletedCriteria(entry, achievement);
+    RefreshCompletedCriteriaCache(entry, achievement);
 
     if (entry->StartTimer)
     {
@@ -3230,6 +3283,16 @@ char const* AchievementGlobalMgr::GetCriteriaTypeString(AchievementCriteriaTypes
 template class AchievementMgr<Guild>;
 template class AchievementMgr<Player>;
 
+AchievementGlobalMgr::AchievementGlobalMgr()
+{
+    for (uint32 i = 0; i < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++i)
+    {
+        _criteriaUpdateEvents[i] = 0;
+        _criteriaEvaluated[i] = 0;
+        _criteriaUpdated[i] = 0;
+    }
+}
+
 AchievementGlobalMgr* AchievementGlobalMgr::instance()
 {
     static AchievementGlobalMgr instance;
@@ -3278,8 +3341,33 @@ inline bool IsAchievementCriteriaTypeStoredByMiscValue(AchievementCriteriaTypes
     return false;
 }
 
+/**
+ * Returns the value criteria of the given type are indexed by in m_AchievementCriteriasByMiscValue,
+ * extracted from the arguments of UpdateAchievementCriteria. 0 means all criteria of that type must be checked.
+ */
+uint32 AchievementGlobalMgr::GetAchievementCriteriaLookupValue(AchievementCriteriaTypes type, uint64 miscValue1, uint64 /*miscValue2*/, uint64 miscValue3)
+{
+    if (!IsAchievementCriteriaTypeStoredByMiscValue(type))
+        return 0;
+
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+            // miscValue1 = itemId, miscValue3 = loot_type
+            return uint32(miscValue3);
+        default:
+            break;
+    }
+
+    return uint32(miscValue1);
+}
+
 AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue, bool guild) const
 {
+    // criteria stored by misc value can only progress when the misc value matches their asset,
+    // no need to look at the whole type if nothing is indexed for that value
+    static AchievementCriteriaEntryList const EmptyCriteriaList;
+
     if (guild)
     {
         if (miscValue && IsAchievementCriteriaTypeStoredByMiscValue(type))
@@ -3287,6 +3375,8 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
             auto itr = m_GuildAchievementCriteriasByMiscValue[type].find(miscValue);
             if (itr != m_GuildAchievementCriteriasByMiscValue[type].end())
                 return itr->second;
+
+            return EmptyCriteriaList;
         }
 
         return m_GuildAchievementCriteriasByType[type];
@@ -3298,12 +3388,43 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
             auto itr = m_AchievementCriteriasByMiscValue[type].find(miscValue);
             if (itr != m_AchievementCriteriasByMiscValue[type].end())
                 return itr->second;
+
+            return EmptyCriteriaList;
         }
 
         return m_AchievementCriteriasByType[type];
     }
 }
 
+void AchievementGlobalMgr::RecordCriteriaUpdate(AchievementCriteriaTypes type, uint32 evaluated, uint32 updated)
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    _criteriaUpdateEvents[type].fetch_add(1, std::memory_order_relaxed);
+    if (evaluated)
+        _criteriaEvaluated[type].fetch_add(evaluated, std::memory_order_relaxed);
+    if (updated)
+        _criteriaUpdated[type].fetch_add(updated, std::memory_order_relaxed);
+}
+
+void AchievementGlobalMgr::LogCriteriaMetrics()
+{
+    for (uint32 i = 0; i < ACHIEVEMENT_CRITERIA_TYPE_TOTAL; ++i)
+    {
+        uint32 events = _criteriaUpdateEvents[i].exchange(0, std::memory_order_relaxed);
+        uint32 evaluated = _criteriaEvaluated[i].exchange(0, std::memory_order_relaxed);
+        uint32 updated = _criteriaUpdated[i].exchange(0, std::memory_order_relaxed);
+        if (!events)
+            continue;
+
+        std::string const tags = ",type=" + std::to_string(i);
+        FC_METRIC_VALUE("achievement_criteria_events" + tags, events);
+        FC_METRIC_VALUE("achievement_criteria_evaluated" + tags, evaluated);
+        FC_METRIC_VALUE("achievement_criteria_updated" + tags, updated);
+    }
+}
+
 bool AchievementGlobalMgr::IsRealmCompleted(AchievementEntry const* achievement) const
 {
     auto itr = _allCompletedAchievements.find(achievement->ID);
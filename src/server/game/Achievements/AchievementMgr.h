@@ -22,6 +22,8 @@
 #include "DBCEnums.h"
 #include "DBCStores.h"
 #include "ObjectGuid.h"
+#include <array>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -291,6 +293,9 @@ class FC_GAME_API AchievementMgr
         void CompletedCriteriaFor(AchievementEntry const* achievement, Player* referencePlayer);
         bool IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement);
         bool IsCompletedAchievement(AchievementEntry const* entry);
+        bool IsCompletedCriteriaCached(uint32 criteriaId) const;
+        void SetCompletedCriteriaCached(uint32 criteriaId, bool completed);
+        void RefreshCompletedCriteriaCache(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement);
         bool CanUpdateCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, Unit const* unit, Player* referencePlayer, GameObject* go = nullptr);
         void SendPacket(WorldPacket const* data) const;
 
@@ -303,12 +308,13 @@ class FC_GAME_API AchievementMgr
         CompletedAchievementMap m_completedAchievements;
         typedef std::map<uint32, uint32> TimedAchievementMap;
         TimedAchievementMap m_timedAchievements;      // Criteria id/time left in MS
+        std::vector<bool> m_completedCriteria;        // Criteria id -> known completed, cleared whenever the criteria progress changes
         uint32 _achievementPoints;
 };
 
 class FC_GAME_API AchievementGlobalMgr
 {
-        AchievementGlobalMgr() { }
+        AchievementGlobalMgr();
         ~AchievementGlobalMgr() { }
 
     public:
@@ -318,6 +324,11 @@ class FC_GAME_API AchievementGlobalMgr
         static AchievementGlobalMgr* instance();
 
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscValue, bool guild = false) const;
+        static uint32 GetAchievementCriteriaLookupValue(AchievementCriteriaTypes type, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3);
+
+        // per criteria type statistics of UpdateAchievementCriteria calls, flushed to the metric system periodically
+        void RecordCriteriaUpdate(AchievementCriteriaTypes type, uint32 evaluated, uint32 updated);
+        void LogCriteriaMetrics();
 
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
@@ -416,6 +427,11 @@ class FC_GAME_API AchievementGlobalMgr
 
         AchievementRewards m_achievementRewards;
         AchievementRewardLocales m_achievementRewardLocales;
+
+        // criteria update statistics, updated concurrently from map threads
+        std::array<std::atomic<uint32>, ACHIEVEMENT_CRITERIA_TYPE_TOTAL> _criteriaUpdateEvents;
+        std::array<std::atomic<uint32>, ACHIEVEMENT_CRITERIA_TYPE_TOTAL> _criteriaEvaluated;
+        std::array<std::atomic<uint32>, ACHIEVEMENT_CRITERIA_TYPE_TOTAL> _criteriaUpdated;
 };
 
 #define sAchievementMgr AchievementGlobalMgr::instance()
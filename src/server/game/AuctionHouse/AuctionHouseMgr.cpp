@@ -28,6 +28,7 @@
 #include "Language.h"
 #include "Log.h"
 #include "Mail.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -42,7 +43,7 @@ enum eAuctionHouse
     AH_MINIMUM_DEPOSIT = 100
 };
 
-AuctionHouseMgr::AuctionHouseMgr() { }
+AuctionHouseMgr::AuctionHouseMgr() : _settlementBacklog(0), _settledAuctions(0) { }
 
 AuctionHouseMgr::~AuctionHouseMgr()
 {
@@ -548,7 +549,7 @@ void AuctionHouseMgr::UpdatePendingAuctions()
             {
                 AuctionEntry* AH = (*AHitr);
                 ++AHitr;
-                AH->expire_time = GameTime::GetGameTime();
+                GetAuctionsMapByHouseId(AH->GetHouseId())->SetAuctionExpireTime(AH, GameTime::GetGameTime());
                 AH->DeleteFromDB(trans);
                 AH->SaveToDB(trans);
             }
@@ -564,6 +565,28 @@ void AuctionHouseMgr::Update()
     mHordeAuctions.Update();
     mAllianceAuctions.Update();
     mNeutralAuctions.Update();
+
+    _settlementBacklog = mHordeAuctions.GetSettlementBacklog() + mAllianceAuctions.GetSettlementBacklog() + mNeutralAuctions.GetSettlementBacklog();
+}
+
+void AuctionHouseMgr::UpdateSettlements()
+{
+    uint32 batchSize = sWorld->getIntConfig(CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE);
+
+    uint32 settled = mHordeAuctions.UpdateSettlements(batchSize);
+    settled += mAllianceAuctions.UpdateSettlements(batchSize);
+    settled += mNeutralAuctions.UpdateSettlements(batchSize);
+    if (!settled)
+        return;
+
+    _settledAuctions += settled;
+    _settlementBacklog = mHordeAuctions.GetSettlementBacklog() + mAllianceAuctions.GetSettlementBacklog() + mNeutralAuctions.GetSettlementBacklog();
+}
+
+void AuctionHouseMgr::LogMetrics()
+{
+    FC_METRIC_VALUE("auction_settlement_backlog", _settlementBacklog.load());
+    FC_METRIC_VALUE("auctions_settled", _settledAuctions.exchange(0));
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -594,14 +617,28 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntryFromHouse(uint8 ho
     return (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_AUCTION)) ? sAuctionHouseStore.LookupEntry(AUCTIONHOUSE_NEUTRAL) : sAuctionHouseStore.LookupEntry(houseId);
 }
 
+static time_t GetExpiryBucket(time_t expireTime)
+{
+    return expireTime / MINUTE;
+}
+
 void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 {
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    ExpiryQueue[GetExpiryBucket(auction->expire_time)].push_back(auction->Id);
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
+void AuctionHouseObject::SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    if (GetExpiryBucket(auction->expire_time) != GetExpiryBucket(expireTime))
+        ExpiryQueue[GetExpiryBucket(expireTime)].push_back(auction->Id);
+
+    auction->expire_time = expireTime;
+}
+
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
@@ -631,45 +668,83 @@ void AuctionHouseObject::Update()
             ++itr;
     }
 
+    ///- queue auctions expired on next update, the last due bucket may still hold some that are not
+    time_t lastDueBucket = GetExpiryBucket(curTime + 60);
+    std::vector<uint32> notYetDue;
+    for (AuctionExpiryQueue::iterator itr = ExpiryQueue.begin(); itr != ExpiryQueue.end() && itr->first <= lastDueBucket;)
+    {
+        for (uint32 auctionId : itr->second)
+        {
+            AuctionEntry* auction = GetAuction(auctionId);
+            // removed, or re-timed and queued again in another bucket
+            if (!auction || GetExpiryBucket(auction->expire_time) != itr->first)
+                continue;
+
+            if (auction->expire_time > curTime + 60)
+                notYetDue.push_back(auctionId);
+            else
+                SettlementQueue.push_back(auctionId);
+        }
+
+        itr = ExpiryQueue.erase(itr);
+    }
+
+    if (!notYetDue.empty())
+        ExpiryQueue[lastDueBucket] = std::move(notYetDue);
+}
+
+uint32 AuctionHouseObject::UpdateSettlements(uint32 batchSize)
+{
+    if (SettlementQueue.empty())
+        return 0;
+
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
-    for (AuctionEntryMap::iterator it = AuctionsMap.begin(); it != AuctionsMap.end();)
+    uint32 settled = 0;
+    while (!SettlementQueue.empty() && settled < batchSize)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = it->second;
-        // Increment iterator due to AuctionEntry deletion
-        ++it;
+        AuctionEntry* auction = GetAuction(SettlementQueue.front());
+        SettlementQueue.pop_front();
 
-        ///- filter auctions expired on next update
-        if (auction->expire_time > curTime + 60)
+        // bought out or cancelled while waiting for its batch
+        if (!auction)
             continue;
 
-        ///- Either cancel the auction if there was no bidder
-        if (auction->bidder == 0 && auction->bid == 0)
-        {
-            sAuctionMgr->SendAuctionExpiredMail(auction, trans);
-            sScriptMgr->OnAuctionExpire(this, auction);
-        }
-        ///- Or perform the transaction
-        else
-        {
-            //we should send an "item sold" message if the seller is online
-            //we send the item to the winner
-            //we send the money to the seller
-            sAuctionMgr->SendAuctionSuccessfulMail(auction, trans);
-            sAuctionMgr->SendAuctionWonMail(auction, trans);
-            sScriptMgr->OnAuctionSuccessful(this, auction);
-        }
+        SettleAuction(auction, trans);
+        ++settled;
+    }
 
-        ///- In any case clear the auction
-        auction->DeleteFromDB(trans);
+    // Run DB changes
+    if (settled)
+        CharacterDatabase.CommitTransaction(trans);
+
+    return settled;
+}
 
-        sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
-        RemoveAuction(auction);
+void AuctionHouseObject::SettleAuction(AuctionEntry* auction, CharacterDatabaseTransaction& trans)
+{
+    ///- Either cancel the auction if there was no bidder
+    if (auction->bidder == 0 && auction->bid == 0)
+    {
+        sAuctionMgr->SendAuctionExpiredMail(auction, trans);
+        sScriptMgr->OnAuctionExpire(this, auction);
+    }
+    ///- Or perform the transaction
+    else
+    {
+        //we should send an "item sold" message if the seller is online
+        //we send the item to the winner
+        //we send the money to the seller
+        sAuctionMgr->SendAuctionSuccessfulMail(auction, trans);
+        sAuctionMgr->SendAuctionWonMail(auction, trans);
+        sScriptMgr->OnAuctionSuccessful(this, auction);
     }
 
-    // Run DB changes
-    CharacterDatabase.CommitTransaction(trans);
+    ///- In any case clear the auction
+    auction->DeleteFromDB(trans);
+
+    sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
+    RemoveAuction(auction);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -21,9 +21,12 @@
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
 #include "ObjectGuid.h"
+#include <atomic>
+#include <deque>
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 class Item;
 class Player;
@@ -115,6 +118,7 @@ class FC_GAME_API AuctionHouseObject
 
     typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
     typedef std::unordered_map<ObjectGuid, time_t> PlayerGetAllThrottleMap;
+    typedef std::map<time_t, std::vector<uint32>> AuctionExpiryQueue;
 
     uint32 Getcount() const { return AuctionsMap.size(); }
 
@@ -131,8 +135,16 @@ class FC_GAME_API AuctionHouseObject
 
     bool RemoveAuction(AuctionEntry* auction);
 
+    // expire_time of an auction already in the house must only be changed through here to keep the expiry queue in sync
+    void SetAuctionExpireTime(AuctionEntry* auction, time_t expireTime);
+
+    // moves auctions expiring before the next update to the settlement queue
     void Update();
 
+    // settles at most batchSize queued auctions in one transaction, returns the number settled
+    uint32 UpdateSettlements(uint32 batchSize);
+    uint32 GetSettlementBacklog() const { return uint32(SettlementQueue.size()); }
+
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListAuctionItems(WorldPacket& data, Player* player,
@@ -141,8 +153,17 @@ class FC_GAME_API AuctionHouseObject
         uint32& count, uint32& totalcount, bool getall = false);
 
   private:
+    void SettleAuction(AuctionEntry* auction, CharacterDatabaseTransaction& trans);
+
     AuctionEntryMap AuctionsMap;
 
+    // Auction ids keyed by the minute they expire in. Entries of auctions removed
+    // or re-timed since they were queued are dropped when their bucket comes due
+    AuctionExpiryQueue ExpiryQueue;
+
+    // Expired auctions waiting for their mails, settled a batch per world tick
+    std::deque<uint32> SettlementQueue;
+
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     PlayerGetAllThrottleMap GetAllThrottleMap;
@@ -197,8 +218,11 @@ class FC_GAME_API AuctionHouseMgr
         uint32 PendingAuctionCount(Player const* player) const;
         void PendingAuctionProcess(Player* player);
         void UpdatePendingAuctions();
+        void UpdateSettlements();
         void Update();
 
+        void LogMetrics();
+
     private:
 
         AuctionHouseObject mHordeAuctions;
@@ -208,6 +232,9 @@ class FC_GAME_API AuctionHouseMgr
         std::map<ObjectGuid, AuctionPair> pendingAuctionMap;
 
         ItemMap mAitems;
+
+        std::atomic<uint32> _settlementBacklog;
+        std::atomic<uint32> _settledAuctions;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
@@ -46,6 +46,10 @@ BattlegroundQueue::BattlegroundQueue()
                 m_WaitTimes[i][j][k] = 0;
         }
     }
+
+    for (uint32 i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
+        for (uint32 j = 0; j < BG_QUEUE_GROUP_TYPES_COUNT; ++j)
+            m_UninvitedPlayers[i][j] = 0;
 }
 
 BattlegroundQueue::~BattlegroundQueue()
@@ -129,6 +133,43 @@ bool BattlegroundQueue::SelectionPool::AddGroup(GroupQueueInfo* ginfo, uint32 de
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
 
+// groups already invited can't be selected again, only uninvited ones are counted and indexed
+void BattlegroundQueue::IndexGroup(GroupQueueInfo* ginfo)
+{
+    m_UninvitedPlayers[ginfo->BracketId][ginfo->QueueType] += ginfo->Players.size();
+    if (ginfo->IsRated && ginfo->ArenaType && ginfo->QueueType < BG_TEAMS_COUNT)
+        m_RatedArenaTeams[ginfo->BracketId][ginfo->QueueType].Add(ginfo, ginfo->ArenaMatchmakerRating, ginfo->JoinTime);
+}
+
+void BattlegroundQueue::UnindexGroup(GroupQueueInfo* ginfo)
+{
+    m_UninvitedPlayers[ginfo->BracketId][ginfo->QueueType] -= ginfo->Players.size();
+    if (ginfo->QueueType < BG_TEAMS_COUNT)
+        m_RatedArenaTeams[ginfo->BracketId][ginfo->QueueType].Remove(ginfo);
+}
+
+// moves the group to the front of another queue of its bracket
+void BattlegroundQueue::MoveGroupToQueue(GroupQueueInfo* ginfo, uint32 queueType)
+{
+    if (!ginfo->IsInvitedToBGInstanceGUID)
+        UnindexGroup(ginfo);
+
+    GroupsQueueType& queue = m_QueuedGroups[ginfo->BracketId][queueType];
+    queue.splice(queue.begin(), m_QueuedGroups[ginfo->BracketId][ginfo->QueueType], ginfo->QueuePosition);
+    ginfo->QueueType = queueType;
+
+    if (!ginfo->IsInvitedToBGInstanceGUID)
+        IndexGroup(ginfo);
+}
+
+bool BattlegroundQueue::HasUninvitedPlayers(BattlegroundBracketId bracket_id) const
+{
+    for (uint32 i = 0; i < BG_QUEUE_GROUP_TYPES_COUNT; ++i)
+        if (m_UninvitedPlayers[bracket_id][i])
+            return true;
+    return false;
+}
+
 // add group or player (grp == nullptr) to bg queue with the given leader and bg specifications
 GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, BattlegroundTypeId BgTypeId, PvPDifficultyEntry const*  bracketEntry, uint8 ArenaType, bool isRated, bool isPremade, uint32 ArenaRating, uint32 MatchmakerRating, uint32 arenateamid)
 {
@@ -194,7 +235,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
 
     //add GroupInfo to m_QueuedGroups
     {
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        ginfo->BracketId = bracketId;
+        ginfo->QueueType = index;
+        ginfo->QueuePosition = m_QueuedGroups[bracketId][index].insert(m_QueuedGroups[bracketId][index].end(), ginfo);
+        IndexGroup(ginfo);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -202,17 +246,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
             if (Battleground* bg = sBattlegroundMgr->GetBattlegroundTemplate(ginfo->BgTypeId))
             {
                 uint32 MinPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_UninvitedPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_UninvitedPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = bracketEntry->MinLevel;
                 uint32 q_max_level = bracketEntry->MaxLevel;
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qAlliance += (*itr)->Players.size();
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qHorde += (*itr)->Players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_PLAYERONLY))
@@ -286,7 +323,6 @@ uint32 BattlegroundQueue::GetAverageQueueWaitTime(GroupQueueInfo* ginfo, Battleg
 //remove player from queue and from group info, if group info is empty then remove it too
 void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 {
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
     QueuedPlayersMap::iterator itr;
 
     //remove player from map, if he's there
@@ -302,39 +338,9 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-
-    uint32 index = (group->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
-
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_TEAMS_COUNT)
-        {
-            GroupsQueueType::iterator k = m_QueuedGroups[bracket_id_tmp][j].begin();
-            for (; k != m_QueuedGroups[bracket_id_tmp][j].end(); ++k)
-            {
-                if ((*k) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = k;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
+    // the group keeps track of where it is queued, even after it was moved between queues
+    BattlegroundBracketId bracket_id = group->BracketId;
 
-    //player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        LOG_ERROR("bg.battleground", "BattlegroundQueue: ERROR Cannot find groupinfo for %s", guid.ToString().c_str());
-        return;
-    }
     LOG_DEBUG("bg.battleground", "BattlegroundQueue: Removing %s, from bracket_id %u", guid.ToString().c_str(), (uint32)bracket_id);
 
     // ALL variables are correctly set
@@ -345,7 +351,11 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove player queue info from group queue info
     std::map<ObjectGuid, PlayerQueueInfo*>::iterator pitr = group->Players.find(guid);
     if (pitr != group->Players.end())
+    {
         group->Players.erase(pitr);
+        if (!group->IsInvitedToBGInstanceGUID)
+            --m_UninvitedPlayers[bracket_id][group->QueueType];
+    }
 
     // if invited to bg, and should decrease invited count, then do it
     if (decreaseInvitedCount && group->IsInvitedToBGInstanceGUID)
@@ -377,7 +387,9 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        if (!group->IsInvitedToBGInstanceGUID)
+            UnindexGroup(group);
+        m_QueuedGroups[bracket_id][group->QueueType].erase(group->QueuePosition);
         delete group;
         return;
     }
@@ -439,6 +451,7 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     {
         // not yet invited
         // set invitation
+        UnindexGroup(ginfo);
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
         BattlegroundTypeId bgTypeId = bg->GetTypeID();
         BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, bg->GetArenaType());
@@ -650,8 +663,7 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
             if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + i);
             }
         }
     }
@@ -662,6 +674,10 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
 // this method tries to create battleground or arena with MinPlayersPerTeam against MinPlayersPerTeam
 bool BattlegroundQueue::CheckNormalMatch(Battleground* /*bg_template*/, BattlegroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers)
 {
+    // neither side can fill a selection pool, no need to walk the queues
+    if (!sBattlegroundMgr->isTesting() && m_UninvitedPlayers[bracket_id][BG_QUEUE_NORMAL_ALLIANCE] < minPlayers && m_UninvitedPlayers[bracket_id][BG_QUEUE_NORMAL_HORDE] < minPlayers)
+        return false;
+
     GroupsQueueType::const_iterator itr_team[BG_TEAMS_COUNT];
     for (uint32 i = 0; i < BG_TEAMS_COUNT; i++)
     {
@@ -721,13 +737,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     //store last ginfo pointer
     GroupQueueInfo* ginfo = m_SelectionPools[teamIndex].SelectedGroups.back();
     //set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].begin();
-    for (; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end())
+    if (ginfo->QueueType != BG_QUEUE_NORMAL_ALLIANCE + teamIndex)
         return false;
-    GroupsQueueType::iterator itr_team2 = itr_team;
+    GroupsQueueType::iterator itr_team2 = ginfo->QueuePosition;
     ++itr_team2;
     //invite players to other selection pool
     for (; itr_team2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr_team2)
@@ -744,19 +756,8 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     {
         //set correct team
         (*itr)->Team = otherTeamId;
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeam].push_front(*itr);
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].erase(itr2);
-                break;
-            }
-        }
+        //move team to other queue
+        MoveGroupToQueue(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeam);
     }
     return true;
 }
@@ -773,11 +774,8 @@ should be called from Battleground::RemovePlayer function in some cases
 */
 void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType, bool isRated, uint32 arenaRating)
 {
-    //if no players in queue - do nothing
-    if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty())
+    //if no players in queue that can still be invited - do nothing
+    if (!HasUninvitedPlayers(bracket_id))
         return;
 
     // battleground with free slot for player should be always in the beggining of the queue
@@ -917,33 +915,23 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
         //set rating range
         uint32 arenaMinRating = (arenaRating <= sBattlegroundMgr->GetMaxRatingDifference()) ? 0 : arenaRating - sBattlegroundMgr->GetMaxRatingDifference();
         uint32 arenaMaxRating = arenaRating + sBattlegroundMgr->GetMaxRatingDifference();
-        // if max rating difference is set and the time past since server startup is greater than the rating discard time
-        // (after what time the ratings aren't taken into account when making teams) then
-        // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
-        // else leave the discard time on 0, this way all ratings will be discarded
-        // this has to be signed value - when the server starts, this value would be negative and thus overflow
-        int32 discardTime = GameTime::GetGameTimeMS() - sBattlegroundMgr->GetRatingDiscardTimer();
+        // teams that waited longer than the rating discard time (after what time the ratings aren't taken into account
+        // when making teams) are matched regardless of their rating, compared as a time difference so it survives wrap around
+        uint32 now = GameTime::GetGameTimeMS();
+        uint32 ratingDiscardTimer = sBattlegroundMgr->GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        // take the team of each faction that joined first and matches the rating range, only the buckets overlapping the range are looked at
+        GroupQueueInfo* teams[BG_TEAMS_COUNT];
         uint8 found = 0;
         uint8 team = 0;
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            if (GroupQueueInfo* ginfo = m_RatedArenaTeams[bracket_id][i].FindOldest(arenaMinRating, arenaMaxRating, now, ratingDiscardTimer))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                teams[found++] = ginfo;
+                team = i;
             }
         }
 
@@ -952,24 +940,17 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
 
         if (found == 1)
         {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
+            uint32 arenaTeamId = teams[0]->ArenaTeamId;
+            if (GroupQueueInfo* ginfo = m_RatedArenaTeams[bracket_id][team].FindOldest(arenaMinRating, arenaMaxRating, now, ratingDiscardTimer,
+                [arenaTeamId](GroupQueueInfo* other) { return other->ArenaTeamId == arenaTeamId; }))
+                teams[found++] = ginfo;
         }
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
+            GroupQueueInfo* aTeam = teams[TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = teams[TEAM_HORDE];
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
             {
@@ -986,15 +967,9 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
 
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->Team != ALLIANCE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
+                MoveGroupToQueue(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
             if (hTeam->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
+                MoveGroupToQueue(hTeam, BG_QUEUE_PREMADE_HORDE);
 
             arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
             arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
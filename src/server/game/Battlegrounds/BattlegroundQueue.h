@@ -22,6 +22,7 @@
 #include "DBCEnums.h"
 #include "Battleground.h"
 #include "EventProcessor.h"
+#include "RatingBucketQueue.h"
 
 #include <deque>
 
@@ -52,6 +53,9 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    BattlegroundBracketId BracketId;                        // bracket the group is queued in
+    uint32  QueueType;                                      // BattlegroundQueueGroupTypes queue the group is stored in
+    std::list<GroupQueueInfo*>::iterator QueuePosition;     // position in that queue, stays valid while the group is queued
 };
 
 enum BattlegroundQueueGroupTypes
@@ -129,6 +133,18 @@ class FC_GAME_API BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+
+        // keep the counters and rating index of groups that can still be invited in sync with m_QueuedGroups
+        void IndexGroup(GroupQueueInfo* ginfo);
+        void UnindexGroup(GroupQueueInfo* ginfo);
+        void MoveGroupToQueue(GroupQueueInfo* ginfo, uint32 queueType);
+        bool HasUninvitedPlayers(BattlegroundBracketId bracket_id) const;
+
+        // players of groups not yet invited, per queue
+        uint32 m_UninvitedPlayers[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+        // rated arena teams not yet invited, per premade queue, bucketed by matchmaker rating
+        RatingBucketQueue<GroupQueueInfo> m_RatedArenaTeams[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+
         uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
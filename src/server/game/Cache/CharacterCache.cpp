@@ -17,18 +17,53 @@
 
 #include "CharacterCache.h"
 #include "ArenaTeam.h"
+#include "ConcurrentLookupTable.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "Player.h"
 #include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
-#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace
 {
-    std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    struct CharacterCacheGuidOf
+    {
+        ObjectGuid const& operator()(CharacterCacheEntry const& entry) const { return entry.Guid; }
+    };
+
+    struct CharacterCacheNameOf
+    {
+        std::string const& operator()(CharacterCacheEntry const& entry) const { return entry.Name; }
+    };
+
+    // Entries are never moved or freed, so the pointers handed out stay valid. Guid, name, race
+    // and gender of a published entry never change, updating them publishes a new entry instead.
+    // The other fields are relaxed atomics updated in place
+    std::deque<CharacterCacheEntry> _characterCacheEntries;
+    ConcurrentLookupTable<ObjectGuid, CharacterCacheEntry, CharacterCacheGuidOf> _characterCacheStore;
+    // keyed by the name stored in the entry itself, so every name is kept once
+    ConcurrentLookupTable<std::string, CharacterCacheEntry, CharacterCacheNameOf> _characterCacheByNameStore;
+    // serializes all modifications, lookups never take it
+    std::mutex _characterCacheWriteLock;
+
+    CharacterCacheEntry* PublishCharacterCacheEntry(CharacterCacheEntry&& entry)
+    {
+        _characterCacheEntries.push_back(std::move(entry));
+        CharacterCacheEntry* published = &_characterCacheEntries.back();
+
+        if (CharacterCacheEntry* previous = _characterCacheStore.Find(published->Guid))
+            if (_characterCacheByNameStore.Find(previous->Name) == previous)
+                _characterCacheByNameStore.Remove(previous->Name);
+
+        _characterCacheStore.Insert(published);
+        _characterCacheByNameStore.Insert(published);
+        return published;
+    }
 }
 
 CharacterCache::CharacterCache()
@@ -68,24 +103,87 @@ CharacterCache* CharacterCache::instance()
 
 void CharacterCache::LoadCharacterCacheStorage()
 {
-    _characterCacheStore.clear();
     uint32 oldMSTime = getMSTime();
 
-    QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters");
-    if (!result)
+    // Every synchronous connection streams its own guid range of the characters table
+    uint32 partCount = 0;
+    uint64 firstGuid = 0;
+    uint64 partSize = 0;
+    if (PreparedQueryResult range = CharacterDatabase.Query(CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GUID_RANGE)))
+    {
+        Field* fields = range->Fetch();
+        if (!fields[0].IsNull())
+        {
+            firstGuid = fields[0].GetUInt32();
+            uint64 guidCount = uint64(fields[1].GetUInt32()) - firstGuid + 1;
+            partCount = uint32(std::min<uint64>(std::max<uint32>(CharacterDatabase.GetSynchConnectionCount(), 1), guidCount));
+            partSize = (guidCount + partCount - 1) / partCount;
+        }
+    }
+
+    std::vector<std::vector<CharacterCacheEntry>> parts(partCount);
+    std::vector<std::thread> loaders;
+    for (uint32 part = 0; part < partCount; ++part)
+    {
+        uint64 begin = firstGuid + part * partSize;
+        loaders.emplace_back([&entries = parts[part], begin, end = begin + partSize]()
+        {
+            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_CACHE);
+            stmt->setUInt64(0, begin);
+            stmt->setUInt64(1, end);
+            PreparedQueryCursor result = CharacterDatabase.StreamQuery(stmt);
+            if (!result)
+                return;
+
+            do
+            {
+                Field* fields = result->Fetch();
+                CharacterCacheEntry entry;
+                entry.Guid = ObjectGuid::Create<HighGuid::Player>(fields[0].GetUInt32());
+                entry.Name = fields[1].GetString();
+                entry.AccountId = fields[2].GetUInt32();
+                entry.Race = fields[3].GetUInt8();
+                entry.Sex = fields[4].GetUInt8();
+                entry.Class = fields[5].GetUInt8();
+                entry.Level = fields[6].GetUInt8();
+                entry.GuildId = 0;                  // Will be set in guild loading or guild setting
+                for (uint8 i = 0; i < MAX_ARENA_SLOT; ++i)
+                    entry.ArenaTeamId[i] = 0;       // Will be set in arena teams loading
+
+                entries.push_back(std::move(entry));
+            } while (result->NextRow());
+        });
+    }
+
+    for (std::thread& loader : loaders)
+        loader.join();
+
+    std::size_t count = 0;
+    for (std::vector<CharacterCacheEntry> const& entries : parts)
+        count += entries.size();
+
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    _characterCacheStore.Clear();
+    _characterCacheByNameStore.Clear();
+    _characterCacheEntries.clear();
+
+    if (!count)
     {
         LOG_INFO("server.loading", "No character name data loaded, empty query");
         return;
     }
 
-    do
+    _characterCacheStore.Reserve(count);
+    _characterCacheByNameStore.Reserve(count);
+    for (std::vector<CharacterCacheEntry>& entries : parts)
     {
-        Field* fields = result->Fetch();
-        AddCharacterCacheEntry(ObjectGuid::Create<HighGuid::Player>(fields[0].GetUInt32()) /*guid*/, fields[2].GetUInt32() /*account*/, fields[1].GetString() /*name*/,
-            fields[4].GetUInt8() /*gender*/, fields[3].GetUInt8() /*race*/, fields[5].GetUInt8() /*class*/, fields[6].GetUInt8() /*level*/);
-    } while (result->NextRow());
+        for (CharacterCacheEntry& entry : entries)
+            PublishCharacterCacheEntry(std::move(entry));
+
+        std::vector<CharacterCacheEntry>().swap(entries);
+    }
 
-    LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters in %u ms", _characterCacheStore.size(), GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters in %u ms", _characterCacheStore.Size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
 /*
@@ -93,7 +191,7 @@ Modifying functions
 */
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
+    CharacterCacheEntry data;
     data.Guid = guid;
     data.Name = name;
     data.AccountId = accountId;
@@ -105,74 +203,88 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
     for (uint8 i = 0; i < MAX_ARENA_SLOT; ++i)
         data.ArenaTeamId[i] = 0;                // Will be set in arena teams loading
 
-    // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    PublishCharacterCacheEntry(std::move(data));
 }
 
 void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    _characterCacheStore.Remove(guid);
+    _characterCacheByNameStore.Remove(name);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, uint8* gender /*= nullptr*/, uint8* race /*= nullptr*/)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
-        return;
+    {
+        std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+        CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+        if (!entry)
+            return;
+
+        // readers may be copying the old name right now, publish a changed copy instead
+        CharacterCacheEntry data = *entry;
+        data.Name = name;
 
-    std::string oldName = itr->second.Name;
-    itr->second.Name = name;
+        if (gender)
+            data.Sex = *gender;
 
-    if (gender)
-        itr->second.Sex = *gender;
+        if (race)
+            data.Race = *race;
 
-    if (race)
-        itr->second.Race = *race;
+        PublishCharacterCacheEntry(std::move(data));
+    }
 
     WorldPacket data(SMSG_INVALIDATE_PLAYER, 8);
     data << guid;
     sWorld->SendGlobalMessage(&data);
-
-    // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    CharacterCacheEntry* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return;
 
-    itr->second.Level = level;
+    entry->Level = level;
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    CharacterCacheEntry* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return;
 
-    itr->second.AccountId = accountId;
+    entry->AccountId = accountId;
 }
 
 void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::LowType guildId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    CharacterCacheEntry* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return;
 
-    itr->second.GuildId = guildId;
+    entry->GuildId = guildId;
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    CharacterCacheEntry* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return;
 
-    itr->second.ArenaTeamId[slot] = arenaTeamId;
+    entry->ArenaTeamId[slot] = arenaTeamId;
+}
+
+void CharacterCache::ReleaseRetiredLookupTables()
+{
+    std::lock_guard<std::mutex> lock(_characterCacheWriteLock);
+    _characterCacheStore.ReleaseRetiredTables();
+    _characterCacheByNameStore.ReleaseRetiredTables();
 }
 
 /*
@@ -180,109 +292,99 @@ Getters
 */
 bool CharacterCache::HasCharacterCacheEntry(ObjectGuid const& guid) const
 {
-    return _characterCacheStore.find(guid) != _characterCacheStore.end();
+    return _characterCacheStore.Find(guid) != nullptr;
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid const& guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr != _characterCacheStore.end())
-        return &itr->second;
-
-    return nullptr;
+    return _characterCacheStore.Find(guid);
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second;
-
-    return nullptr;
+    return _characterCacheByNameStore.Find(name);
 }
 
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second->Guid;
+    if (CharacterCacheEntry const* entry = _characterCacheByNameStore.Find(name))
+        return entry->Guid;
 
     return ObjectGuid::Empty;
 }
 
 bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return false;
 
-    name = itr->second.Name;
+    name = entry->Name;
     return true;
 }
 
 bool CharacterCache::GetPlayerGuildIdByGUID(ObjectGuid guid, uint32& guildId) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return false;
 
-    if (!itr->second.GuildId)
+    if (!entry->GuildId)
         return false;
 
-    guildId = itr->second.GuildId;
+    guildId = entry->GuildId;
     return true;
 }
 
 uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return 0;
 
-    return Player::TeamForRace(itr->second.Race);
+    return Player::TeamForRace(entry->Race);
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.AccountId;
+    return entry->AccountId;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second->AccountId;
+    if (CharacterCacheEntry const* entry = _characterCacheByNameStore.Find(name))
+        return entry->AccountId;
 
     return 0;
 }
 
 uint8 CharacterCache::GetCharacterLevelByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.Level;
+    return entry->Level;
 }
 
 ObjectGuid::LowType CharacterCache::GetCharacterGuildIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.GuildId;
+    return entry->GuildId;
 }
 
 uint32 CharacterCache::GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.Find(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.ArenaTeamId[ArenaTeam::GetSlotByType(type)];
+    return entry->ArenaTeamId[ArenaTeam::GetSlotByType(type)];
 }
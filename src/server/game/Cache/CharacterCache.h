@@ -20,21 +20,47 @@
 
 #include "Define.h"
 #include "ObjectGuid.h"
+#include <atomic>
 #include <string>
 
+/// Entry field that is updated in place while lookups read it without locking
+template<class T>
+class CharacterCacheField
+{
+    public:
+        CharacterCacheField(T value = T()) : _value(value) { }
+        CharacterCacheField(CharacterCacheField const& right) : _value(T(right)) { }
+
+        CharacterCacheField& operator=(CharacterCacheField const& right) { return *this = T(right); }
+        CharacterCacheField& operator=(T value)
+        {
+            _value.store(value, std::memory_order_relaxed);
+            return *this;
+        }
+
+        operator T() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<T> _value;
+};
+
 struct CharacterCacheEntry
 {
     ObjectGuid Guid;
     std::string Name;
-    uint32 AccountId;
+    CharacterCacheField<uint32> AccountId;
     uint8 Class;
     uint8 Race;
     uint8 Sex;
-    uint8 Level;
-    ObjectGuid::LowType GuildId;
-    uint32 ArenaTeamId[3];
+    CharacterCacheField<uint8> Level;
+    CharacterCacheField<ObjectGuid::LowType> GuildId;
+    CharacterCacheField<uint32> ArenaTeamId[3];
 };
 
+/// Lookups never lock and may run on any thread. Returned entries stay valid for the
+/// lifetime of the server; a rename or customization publishes a new entry, so an entry
+/// obtained earlier keeps the old name. Level, account, guild and arena teams are updated
+/// in place.
 class FC_GAME_API CharacterCache
 {
     public:
@@ -65,6 +91,9 @@ class FC_GAME_API CharacterCache
         uint8 GetCharacterLevelByGuid(ObjectGuid guid) const;
         ObjectGuid::LowType GetCharacterGuildIdByGuid(ObjectGuid guid) const;
         uint32 GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const;
+
+        /// Frees lookup tables replaced by earlier modifications, only while no lookup can run
+        void ReleaseRetiredLookupTables();
 };
 
 #define sCharacterCache CharacterCache::instance()
@@ -36,6 +36,7 @@
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "Map.h"
+#include "Profiler.h"
 #include "RBAC.h"
 #include "SharedDefines.h"
 #include "SocialMgr.h"
@@ -295,6 +296,8 @@ LFGMgr* LFGMgr::instance()
 
 void LFGMgr::Update(uint32 diff)
 {
+    FC_PROFILE_ZONE("LFGMgr::Update");
+
     if (!isOptionEnabled(LFG_OPTION_ENABLE_DUNGEON_FINDER | LFG_OPTION_ENABLE_RAID_BROWSER))
         return;
 
@@ -272,7 +272,8 @@ m_respawnDelay(300), m_corpseDelay(60), m_respawnradius(0.0f), m_boundaryCheckTi
 m_defaultMovementType(IDLE_MOTION_TYPE), m_spawnId(0), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false),
 m_AlreadySearchedAssistance(false), m_regenHealth(true), m_cannotReachTarget(false), m_cannotReachTimer(0), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
 m_originalEntry(0), m_homePosition(), m_transportHomePosition(), m_creatureInfo(nullptr), m_creatureData(nullptr), _waypointPathId(0), _currentWaypointNodeInfo(0, 0), _cyclicSplinePathId(0),
-m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0), _isMissingSwimmingFlagOutOfCombat(false), _noNpcDamageBelowPctHealth(0.f)
+m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0), _isMissingSwimmingFlagOutOfCombat(false), _noNpcDamageBelowPctHealth(0.f),
+    _skippedUpdateDiff(0), _updateTierTimer(0), _updateWakeTimer(0)
 {
     m_valuesCount = UNIT_END;
 
@@ -301,6 +302,9 @@ void Creature::AddToWorld()
 
         UpdatePowerRegeneration(GetPowerType());
 
+        // spread lower tier updates of creatures loaded together over the interval
+        _updateTierTimer = urand(0, sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_INTERVAL_IDLE));
+
         Unit::AddToWorld();
         SearchFormation();
         AIM_Initialize();
@@ -2681,6 +2685,94 @@ void Creature::SetRespawnTime(uint32 respawn)
     m_respawnTime = respawn ? GameTime::GetGameTime() + respawn : 0;
 }
 
+bool Creature::IsUpdateDue(uint32 diff, bool overBudget, uint32& updateDiff)
+{
+    _skippedUpdateDiff += diff;
+    _updateWakeTimer = _updateWakeTimer > diff ? _updateWakeTimer - diff : 0;
+
+    uint32 movingInterval = sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_INTERVAL_MOVING);
+    uint32 idleInterval = sWorld->getIntConfig(CONFIG_CREATURE_UPDATE_INTERVAL_IDLE);
+
+    // update tiers disabled, do not pay for finding the tier
+    if (!movingInterval && !idleInterval)
+    {
+        updateDiff = _skippedUpdateDiff;
+        _skippedUpdateDiff = 0;
+        _updateTierTimer = 0;
+        return true;
+    }
+
+    uint32 interval = 0;
+    switch (GetUpdateTier())
+    {
+        case CREATURE_UPDATE_TIER_MOVING:
+            interval = movingInterval;
+            break;
+        case CREATURE_UPDATE_TIER_IDLE:
+            interval = idleInterval;
+            break;
+        default:
+            break;
+    }
+
+    if (interval)
+    {
+        if (_updateTierTimer > diff)
+        {
+            _updateTierTimer -= diff;
+            return false;
+        }
+
+        // the map ran out of update time this tick, lower tiers wait unless they have been waiting for long
+        if (overBudget && _skippedUpdateDiff < interval * CREATURE_UPDATE_MAX_DEFERRAL)
+            return false;
+
+        _updateTierTimer = interval;
+    }
+    else
+        _updateTierTimer = 0;
+
+    updateDiff = _skippedUpdateDiff;
+    _skippedUpdateDiff = 0;
+    return true;
+}
+
+void Creature::WakeUpdate()
+{
+    _updateWakeTimer = CREATURE_UPDATE_WAKE_TIME;
+    _updateTierTimer = 0;
+}
+
+CreatureUpdateTier Creature::GetUpdateTier() const
+{
+    if (_updateWakeTimer || m_triggerJustAppeared || IsInCombat() || IsInEvadeMode() || HasUnitState(UNIT_STATE_CASTING) ||
+        isWorldBoss() || IsSummon() || IsCharmedOwnedByPlayerOrPlayer() || IsVehicle() || isActiveObject() || GetScriptId())
+        return CREATURE_UPDATE_TIER_ACTIVE;
+
+    // periodic auras tick at most once per update and AI timers fire at most once per update, skipped ticks would be lost
+    if (HasPeriodicAura() || (AI() && AI()->HasScheduledEvents()))
+        return CREATURE_UPDATE_TIER_ACTIVE;
+
+    if (!IsAlive())
+        return CREATURE_UPDATE_TIER_IDLE;
+
+    if (!movespline->Finalized() || GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return CREATURE_UPDATE_TIER_MOVING;
+
+    return CREATURE_UPDATE_TIER_IDLE;
+}
+
+bool Creature::HasPeriodicAura() const
+{
+    for (std::pair<uint32 const, Aura*> const& pair : GetOwnedAuras())
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (AuraEffect const* effect = pair.second->GetEffect(i))
+                if (effect->IsPeriodic())
+                    return true;
+
+    return false;
+}
+
 void Creature::GetRespawnPosition(float &x, float &y, float &z, float* ori, float* dist) const
 {
     if (m_creatureData)
@@ -3325,6 +3417,8 @@ void Creature::AtEngage(Unit* target)
 {
     Unit::AtEngage(target);
 
+    WakeUpdate();
+
     if (!(GetCreatureTemplate()->type_flags & CREATURE_TYPE_FLAG_MOUNTED_COMBAT_ALLOWED))
         Dismount();
 
@@ -55,6 +55,18 @@ typedef std::list<VendorItemCount> VendorItemCounts;
 #define MAX_VENDOR_ITEMS 150                                // Limitation in 4.x.x item count in SMSG_VENDOR_INVENTORY
 static constexpr uint8 VENDOR_INVENTORY_REASON_INVENTORY_EMPTY = 1;
 
+// Creatures that have nothing to react to are updated less often, with the diff of the skipped map ticks
+enum CreatureUpdateTier : uint8
+{
+    CREATURE_UPDATE_TIER_ACTIVE,                            // in combat, scripted, controlled, with periodic auras or recently woken up: every map tick
+    CREATURE_UPDATE_TIER_MOVING,                            // out of combat but following a movement generator
+    CREATURE_UPDATE_TIER_IDLE                               // out of combat and standing still, or dead
+};
+
+#define CREATURE_UPDATE_WAKE_TIME       5000                // time spent in the active tier after a wake up
+#define CREATURE_UPDATE_WAKE_DISTANCE   40.0f               // players closer than this wake creatures up
+#define CREATURE_UPDATE_MAX_DEFERRAL    4                   // over budget, lower tiers wait at most this many intervals
+
 //used for handling non-repeatable random texts
 typedef std::vector<uint8> CreatureTextRepeatIds;
 typedef std::unordered_map<uint8, CreatureTextRepeatIds> CreatureTextRepeatGroup;
@@ -84,6 +96,12 @@ class FC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         ObjectGuid::LowType GetSpawnId() const { return m_spawnId; }
 
         void Update(uint32 time) override;                         // overwrited Unit::Update
+        // Called by the map for every tick the creature is visited, returns true with the diff to update with if it is due
+        bool IsUpdateDue(uint32 diff, bool overBudget, uint32& updateDiff);
+        // Moves the creature to the active update tier for a while, called on aggro, damage or players coming close
+        void WakeUpdate();
+        CreatureUpdateTier GetUpdateTier() const;
+        bool HasPeriodicAura() const;
         void GetRespawnPosition(float &x, float &y, float &z, float* ori = nullptr, float* dist = nullptr) const;
         bool IsSpawnedOnTransport() const { return m_creatureData && m_creatureData->mapId != GetMapId(); }
 
@@ -472,6 +490,11 @@ class FC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         CreatureMovementInfo _creatureMovementInfo;
 
         float _noNpcDamageBelowPctHealth;
+
+        // Update tiers
+        uint32 _skippedUpdateDiff;
+        uint32 _updateTierTimer;
+        uint32 _updateWakeTimer;
 };
 
 class FC_GAME_API AssistDelayEvent : public BasicEvent
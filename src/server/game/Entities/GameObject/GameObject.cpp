@@ -2933,63 +2933,62 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    thread_local FieldBitset fields;
+    SelectValuesUpdateFields(fields, updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount);
+    if (forcedFlags)
+        fields.Set(GAMEOBJECT_FLAGS);
+
+    for (uint32 index = fields.FindNext(0); index < m_valuesCount; index = fields.FindNext(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) &&
-                (flags[index] & visibleFlag)) ||
-            (index == GAMEOBJECT_FLAGS && forcedFlags))
+        updateMask.SetBit(index);
+
+        if (index == GAMEOBJECT_DYNAMIC)
         {
-            updateMask.SetBit(index);
+            uint32 dynamicFlags = m_uint32Values[GAMEOBJECT_DYNAMIC];
 
-            if (index == GAMEOBJECT_DYNAMIC)
+            uint16 dynFlags = 0;
+            uint16 pathProgress = 0xFFFF;
+            switch (GetGoType())
             {
-                uint32 dynamicFlags = m_uint32Values[GAMEOBJECT_DYNAMIC];
-
-                uint16 dynFlags = 0;
-                uint16 pathProgress = 0xFFFF;
-                switch (GetGoType())
-                {
-                case GAMEOBJECT_TYPE_QUESTGIVER:
-                    if (ActivateToQuest(target))
-                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                    break;
-                case GAMEOBJECT_TYPE_CHEST:
-                case GAMEOBJECT_TYPE_GOOBER:
-                    if (ActivateToQuest(target))
-                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                    else if (targetIsGM)
-                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                    break;
-                case GAMEOBJECT_TYPE_GENERIC:
-                    if (ActivateToQuest(target))
-                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                    break;
-                case GAMEOBJECT_TYPE_TRANSPORT:
-                case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                {
-                    dynFlags = dynamicFlags & 0xFFFF;
-                    pathProgress = dynamicFlags >> 16;
-                    break;
-                }
-                default:
-                    break;
-                }
-
-                fieldBuffer << ((uint32(pathProgress) << 16) | uint32(dynFlags));
-            }
-            else if (index == GAMEOBJECT_FLAGS)
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                else if (targetIsGM)
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+            case GAMEOBJECT_TYPE_MO_TRANSPORT:
             {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-
-                fieldBuffer << goFlags;
+                dynFlags = dynamicFlags & 0xFFFF;
+                pathProgress = dynamicFlags >> 16;
+                break;
             }
-            else
-                fieldBuffer << m_uint32Values[index]; // other cases
+            default:
+                break;
+            }
+
+            fieldBuffer << ((uint32(pathProgress) << 16) | uint32(dynFlags));
         }
+        else if (index == GAMEOBJECT_FLAGS)
+        {
+            uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+            fieldBuffer << goFlags;
+        }
+        else
+            fieldBuffer << m_uint32Values[index]; // other cases
     }
 
     updateMask.AppendToPacket(data);
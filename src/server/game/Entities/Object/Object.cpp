@@ -671,20 +671,43 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    thread_local FieldBitset fields;
+    SelectValuesUpdateFields(fields, updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount);
+
+    for (uint32 index = fields.FindNext(0); index < m_valuesCount; index = fields.FindNext(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
+        updateMask.SetBit(index);
+        fieldBuffer << m_uint32Values[index];
     }
 
     updateMask.AppendToPacket(data);
     data->append(fieldBuffer);
 }
 
+void Object::SelectValuesUpdateFields(FieldBitset& fields, uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlags, uint32 valuesCount) const
+{
+    // reused by every values update built on this thread
+    thread_local FieldBitset visible;
+    thread_local FieldBitset forced;
+    thread_local FieldBitset nonZero;
+
+    UpdateFieldFlagMasks const& masks = GetUpdateFieldFlagMasks(flags);
+    visible.Resize(valuesCount);
+    masks.Select(visibleFlag, visible);
+    forced.Resize(valuesCount);
+    masks.Select(forcedFlags, forced);
+
+    fields.Resize(valuesCount);
+    if (updateType == UPDATETYPE_VALUES)
+        fields.AssignAndOr(_changesMask.GetBits(), visible, forced);
+    else
+    {
+        nonZero.Resize(valuesCount);
+        nonZero.AssignNonZero(m_uint32Values, valuesCount);
+        fields.AssignAndOr(nonZero, visible, forced);
+    }
+}
+
 void Object::AddToObjectUpdateIfNeeded()
 {
     if (m_inWorld && !m_objectUpdated)
@@ -1953,6 +1976,19 @@ void WorldObject::SendMessageToSet(WorldPacket const* data, Player const* skippe
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
 }
 
+void WorldObject::SendSharedMessageToSet(std::shared_ptr<WorldPacket const> const& data, bool self) const
+{
+    if (self)
+        if (Player const* player = ToPlayer())
+            player->SendDirectMessage(data);
+
+    if (!IsInWorld())
+        return;
+
+    Firelands::MessageDistDeliverer notifier(this, data, GetVisibilityRange());
+    Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
+}
+
 void WorldObject::SetMap(Map* map)
 {
     ASSERT(map);
@@ -193,6 +193,9 @@ class FC_GAME_API Object
         void _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
         uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+        // selects the fields a values update has to contain: changed (or non-zero when creating) fields
+        // having any of visibleFlag, and all fields having any of forcedFlags
+        void SelectValuesUpdateFields(FieldBitset& fields, uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlags, uint32 valuesCount) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint32 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
@@ -372,6 +375,8 @@ class FC_GAME_API WorldObject : public Object, public WorldLocation
         virtual void SendMessageToSet(WorldPacket const* data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket const* data, float dist, bool self) const;
         virtual void SendMessageToSet(WorldPacket const* data, Player const* skipped_rcvr) const;
+        // every receiver queues a reference to data instead of a copy of it
+        void SendSharedMessageToSet(std::shared_ptr<WorldPacket const> const& data, bool self) const;
 
         virtual uint8 getLevelForTarget(WorldObject const* /*target*/) const { return 1; }
 
@@ -16,6 +16,7 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -1656,3 +1657,27 @@ uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END] =
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+1
     UF_FLAG_PUBLIC,                                         // AREATRIGGER_FINAL_POS+2
 };
+
+UpdateFieldFlagMasks const& GetUpdateFieldFlagMasks(uint32 const* flags)
+{
+    static UpdateFieldFlagMasks const itemMasks(ItemUpdateFieldFlags, CONTAINER_END);
+    static UpdateFieldFlagMasks const unitMasks(UnitUpdateFieldFlags, PLAYER_END);
+    static UpdateFieldFlagMasks const gameObjectMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    static UpdateFieldFlagMasks const dynamicObjectMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    static UpdateFieldFlagMasks const corpseMasks(CorpseUpdateFieldFlags, CORPSE_END);
+    static UpdateFieldFlagMasks const areaTriggerMasks(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
+
+    if (flags == UnitUpdateFieldFlags)
+        return unitMasks;
+    if (flags == GameObjectUpdateFieldFlags)
+        return gameObjectMasks;
+    if (flags == ItemUpdateFieldFlags)
+        return itemMasks;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return dynamicObjectMasks;
+    if (flags == CorpseUpdateFieldFlags)
+        return corpseMasks;
+
+    ASSERT(flags == AreaTriggerUpdateFieldFlags);
+    return areaTriggerMasks;
+}
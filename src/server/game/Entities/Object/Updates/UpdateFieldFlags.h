@@ -21,6 +21,8 @@
 #include "UpdateFields.h"
 #include "Define.h"
 
+class UpdateFieldFlagMasks;
+
 enum UpdatefieldFlags
 {
     UF_FLAG_NONE         = 0x000,
@@ -42,4 +44,7 @@ FC_GAME_API extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 FC_GAME_API extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 FC_GAME_API extern uint32 AreaTriggerUpdateFieldFlags[AREATRIGGER_END];
 
+/// Per flag field sets of one of the tables above
+FC_GAME_API UpdateFieldFlagMasks const& GetUpdateFieldFlagMasks(uint32 const* flags);
+
 #endif // _UPDATEFIELDFLAGS_H
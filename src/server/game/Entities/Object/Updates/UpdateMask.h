@@ -21,43 +21,72 @@
 #include "UpdateFields.h"
 #include "Errors.h"
 #include "ByteBuffer.h"
+#include "FieldBitset.h"
 
 class UpdateMask
 {
 public:
-    UpdateMask() : _bits(nullptr), _fieldCount(0) { }
+    UpdateMask() { }
 
     void SetBit(uint32 index)
     {
-        _bits[index] = 1;
+        _bits.Set(index);
     }
 
     void UnsetBit(uint32 index)
     {
-        _bits[index] = 0;
+        _bits.Reset(index);
     }
 
     bool GetBit(uint32 index) const
     {
-        return _bits[index] != 0;
+        return _bits.Test(index);
     }
 
     void SetCount(uint32 valuesCount)
     {
-        _bits = std::make_unique<uint8[]>(valuesCount);
-        std::uninitialized_fill_n(&_bits[0], valuesCount, 0);
-        _fieldCount = valuesCount;
+        _bits.Resize(valuesCount);
     }
 
     void Clear()
     {
-        if (_bits)
-            std::fill_n(&_bits[0], _fieldCount, 0);
+        _bits.Clear();
+    }
+
+    FieldBitset const& GetBits() const { return _bits; }
+
+private:
+    FieldBitset _bits;
+};
+
+/// Fields of one update field flags table, split by flag, so the fields visible
+/// with a combination of flags can be selected with a few wide ORs
+class UpdateFieldFlagMasks
+{
+public:
+    UpdateFieldFlagMasks(uint32 const* flags, uint32 fieldCount)
+    {
+        for (uint32 flag = 0; flag < MAX_FLAG_BITS; ++flag)
+            _fieldsByFlag[flag].Resize(fieldCount);
+
+        for (uint32 index = 0; index < fieldCount; ++index)
+            for (uint32 flag = 0; flag < MAX_FLAG_BITS; ++flag)
+                if (flags[index] & (1 << flag))
+                    _fieldsByFlag[flag].Set(index);
+    }
+
+    /// Adds all fields having any of flagMask to fields
+    void Select(uint32 flagMask, FieldBitset& fields) const
+    {
+        for (uint32 flag = 0; flag < MAX_FLAG_BITS; ++flag)
+            if (flagMask & (1 << flag))
+                fields.Or(_fieldsByFlag[flag]);
     }
 
 private:
-    std::unique_ptr<uint8[]> _bits;
-    uint32 _fieldCount;
+    static uint32 const MAX_FLAG_BITS = 9; // up to UF_FLAG_DYNAMIC
+
+    FieldBitset _fieldsByFlag[MAX_FLAG_BITS];
 };
 
 class UpdateMaskPacketBuilder
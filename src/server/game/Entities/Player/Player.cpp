@@ -90,6 +90,7 @@
 #include "PetitionMgr.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
+#include "Profiler.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QuestDef.h"
@@ -280,6 +281,7 @@ Player::Player(WorldSession* session) : Unit(true)
     ////////////////////Rest System/////////////////////
 
     m_mailsUpdated = false;
+    m_mailboxState = MAILBOX_NOT_LOADED;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -987,6 +989,8 @@ void Player::SetDrunkValue(uint8 newDrunkValue, uint32 itemId /*= 0*/)
 
 void Player::Update(uint32 p_time)
 {
+    FC_PROFILE_ZONE("Player::Update");
+
     if (!IsInWorld())
         return;
 
@@ -6022,6 +6026,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 cinematicId)
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -17740,9 +17749,6 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
 
     // apply original stats mods before spell loading or item equipment that call before equip _RemoveStatsMods()
 
-    // mails are loaded only when needed ;-) - when player in game click on mailbox.
-    //_LoadMail();
-
     UpdateDisplayPower();
     _LoadTalents(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_TALENTS));
     _LoadSpells(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SPELLS));
@@ -17783,7 +17789,8 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
     _LoadActions(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_ACTIONS));
 
     // unread mails and next delivery time, actual mails not loaded
-    _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS), holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS));
+    // mails are loaded only when needed ;-) - when player in game click on mailbox.
+    _LoadMailSummary(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_SUMMARY));
 
     m_social = sSocialMgr->LoadFromDB(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST), GetGUID());
 
@@ -18558,7 +18565,10 @@ Item* Player::_LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint
 
 void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult)
 {
-    m_mail.clear();
+    // mails delivered while the mailbox was loading are in memory already
+    std::unordered_set<uint32> deliveredMails;
+    for (Mail const* mail : m_mail)
+        deliveredMails.insert(mail->messageID);
 
     std::unordered_map<uint32, Mail*> mailById;
 
@@ -18567,6 +18577,9 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
         do
         {
             Field* fields = mailsResult->Fetch();
+            if (deliveredMails.count(fields[0].GetUInt32()))
+                continue;
+
             Mail* m = new Mail;
 
             m->messageID = fields[0].GetUInt32();
@@ -18601,13 +18614,32 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
         {
             Field* fields = mailItemsResult->Fetch();
             uint32 mailId = fields[15].GetUInt32();
+            if (deliveredMails.count(mailId))
+                continue;
+
             _LoadMailedItem(GetGUID(), this, mailId, mailById[mailId], fields);
         } while (mailItemsResult->NextRow());
     }
 
+    m_mailboxState = MAILBOX_LOADED;
     UpdateNextMailTimeAndUnreads();
 }
 
+void Player::_LoadMailSummary(PreparedQueryResult result)
+{
+    //          0          1
+    // SELECT unread, next_deliver_time FROM mail WHERE receiver = ?
+    unReadMails = 0;
+    m_nextMailDelivereTime = 0;
+    if (!result)
+        return;
+
+    Field* fields = result->Fetch();
+    unReadMails = uint8(std::min<uint64>(fields[0].GetUInt64(), std::numeric_limits<uint8>::max()));
+    if (!fields[1].IsNull())
+        m_nextMailDelivereTime = time_t(fields[1].GetUInt64());
+}
+
 void Player::LoadPet()
 {
     // fixme: the pet should still be loaded if the player is not in world
@@ -23360,6 +23392,8 @@ void Player::UpdateObjectVisibility(bool forced)
 
 void Player::UpdateVisibilityForPlayer()
 {
+    FC_PROFILE_ZONE("Player::UpdateVisibilityForPlayer");
+
     // updates visibility of all objects around point of view for current player
     Firelands::VisibleNotifier notifier(*this);
     Cell::VisitAllObjects(m_seer, notifier, GetSightRange());
@@ -842,38 +842,44 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_REPUTATION = 7,
     PLAYER_LOGIN_QUERY_LOAD_INVENTORY = 8,
     PLAYER_LOGIN_QUERY_LOAD_ACTIONS = 9,
-    PLAYER_LOGIN_QUERY_LOAD_MAILS = 10,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS = 11,
-    PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST = 12,
-    PLAYER_LOGIN_QUERY_LOAD_HOME_BIND = 13,
-    PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS = 14,
-    PLAYER_LOGIN_QUERY_LOAD_DECLINED_NAMES = 15,
-    PLAYER_LOGIN_QUERY_LOAD_GUILD = 16,
-    PLAYER_LOGIN_QUERY_LOAD_ARENA_INFO = 17,
-    PLAYER_LOGIN_QUERY_LOAD_ACHIEVEMENTS = 18,
-    PLAYER_LOGIN_QUERY_LOAD_CRITERIA_PROGRESS = 19,
-    PLAYER_LOGIN_QUERY_LOAD_EQUIPMENT_SETS = 20,
-    PLAYER_LOGIN_QUERY_LOAD_BG_DATA = 21,
-    PLAYER_LOGIN_QUERY_LOAD_GLYPHS = 22,
-    PLAYER_LOGIN_QUERY_LOAD_TALENTS = 23,
-    PLAYER_LOGIN_QUERY_LOAD_ACCOUNT_DATA = 24,
-    PLAYER_LOGIN_QUERY_LOAD_SKILLS = 25,
-    PLAYER_LOGIN_QUERY_LOAD_WEEKLY_QUEST_STATUS = 26,
-    PLAYER_LOGIN_QUERY_LOAD_RANDOM_BG = 27,
-    PLAYER_LOGIN_QUERY_LOAD_BANNED = 28,
-    PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS_REW = 29,
-    PLAYER_LOGIN_QUERY_LOAD_INSTANCE_LOCK_TIMES = 30,
-    PLAYER_LOGIN_QUERY_LOAD_SEASONAL_QUEST_STATUS = 31,
-    PLAYER_LOGIN_QUERY_LOAD_MONTHLY_QUEST_STATUS = 32,
-    PLAYER_LOGIN_QUERY_LOAD_VOID_STORAGE = 33,
-    PLAYER_LOGIN_QUERY_LOAD_CURRENCY = 34,
-    PLAYER_LOGIN_QUERY_LOAD_CUF_PROFILES = 35,
-    PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION = 36,
-    PLAYER_LOGIN_QUERY_LOAD_ALL_PETS = 37,
-    PLAYER_LOGIN_QUERY_LOAD_LFG_REWARD_STATUS = 38,
+    PLAYER_LOGIN_QUERY_LOAD_MAIL_SUMMARY = 10,
+    PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST = 11,
+    PLAYER_LOGIN_QUERY_LOAD_HOME_BIND = 12,
+    PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS = 13,
+    PLAYER_LOGIN_QUERY_LOAD_DECLINED_NAMES = 14,
+    PLAYER_LOGIN_QUERY_LOAD_GUILD = 15,
+    PLAYER_LOGIN_QUERY_LOAD_ARENA_INFO = 16,
+    PLAYER_LOGIN_QUERY_LOAD_ACHIEVEMENTS = 17,
+    PLAYER_LOGIN_QUERY_LOAD_CRITERIA_PROGRESS = 18,
+    PLAYER_LOGIN_QUERY_LOAD_EQUIPMENT_SETS = 19,
+    PLAYER_LOGIN_QUERY_LOAD_BG_DATA = 20,
+    PLAYER_LOGIN_QUERY_LOAD_GLYPHS = 21,
+    PLAYER_LOGIN_QUERY_LOAD_TALENTS = 22,
+    PLAYER_LOGIN_QUERY_LOAD_ACCOUNT_DATA = 23,
+    PLAYER_LOGIN_QUERY_LOAD_SKILLS = 24,
+    PLAYER_LOGIN_QUERY_LOAD_WEEKLY_QUEST_STATUS = 25,
+    PLAYER_LOGIN_QUERY_LOAD_RANDOM_BG = 26,
+    PLAYER_LOGIN_QUERY_LOAD_BANNED = 27,
+    PLAYER_LOGIN_QUERY_LOAD_QUEST_STATUS_REW = 28,
+    PLAYER_LOGIN_QUERY_LOAD_INSTANCE_LOCK_TIMES = 29,
+    PLAYER_LOGIN_QUERY_LOAD_SEASONAL_QUEST_STATUS = 30,
+    PLAYER_LOGIN_QUERY_LOAD_MONTHLY_QUEST_STATUS = 31,
+    PLAYER_LOGIN_QUERY_LOAD_VOID_STORAGE = 32,
+    PLAYER_LOGIN_QUERY_LOAD_CURRENCY = 33,
+    PLAYER_LOGIN_QUERY_LOAD_CUF_PROFILES = 34,
+    PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION = 35,
+    PLAYER_LOGIN_QUERY_LOAD_ALL_PETS = 36,
+    PLAYER_LOGIN_QUERY_LOAD_LFG_REWARD_STATUS = 37,
     MAX_PLAYER_LOGIN_QUERY
 };
 
+enum PlayerMailboxState
+{
+    MAILBOX_NOT_LOADED = 0,  // only the unread summary is known, mails stay in the database
+    MAILBOX_LOADING = 1,     // query in flight, mails delivered meanwhile are kept in memory
+    MAILBOX_LOADED = 2
+};
+
 enum PlayerDelayedOperations
 {
     DELAYED_SAVE_PLAYER = 0x01,
@@ -1805,6 +1811,7 @@ class FC_GAME_API Player : public Unit, public GridObject<Player>
     int32 GetQuestObjectiveCounter(uint32 objectiveId) const;
 
     bool m_mailsUpdated;
+    PlayerMailboxState GetMailboxState() const { return m_mailboxState; }
 
     void SetBindPoint(ObjectGuid guid) const;
     void SendTalentWipeConfirm(ObjectGuid guid) const;
@@ -2557,6 +2564,7 @@ class FC_GAME_API Player : public Unit, public GridObject<Player>
     void SendUpdateWorldState(
         uint32 variable, uint32 value, bool hidden = false) const;
     void SendDirectMessage(WorldPacket const* data) const;
+    void SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const;
     void SendBGWeekendWorldStates() const;
     void SendBattlefieldWorldStates() const;
 
@@ -3059,6 +3067,7 @@ class FC_GAME_API Player : public Unit, public GridObject<Player>
     void _LoadVoidStorage(PreparedQueryResult result);
     void _LoadMail(
         PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult);
+    void _LoadMailSummary(PreparedQueryResult result);
     static Item* _LoadMailedItem(ObjectGuid const& playerGuid, Player* player,
         uint32 mailId, Mail* mail, Field* fields);
     void _LoadQuestStatus(PreparedQueryResult result);
@@ -3183,6 +3192,7 @@ class FC_GAME_API Player : public Unit, public GridObject<Player>
     uint32 m_ArenaTeamIdInvited;
 
     PlayerMails m_mail;
+    PlayerMailboxState m_mailboxState;
     PlayerSpellMap m_spells;
     uint32 m_lastPotionId;  // last used health/mana potion in combat, that
                             // block next potion use
@@ -35,6 +35,66 @@
 #include "Vehicle.h"
 #include <boost/dynamic_bitset.hpp>
 
+namespace
+{
+    bool ErasePassenger(Transport::PassengerSet& passengers, WorldObject* passenger)
+    {
+        auto itr = std::find(passengers.begin(), passengers.end(), passenger);
+        if (itr == passengers.end())
+            return false;
+
+        *itr = passengers.back();
+        passengers.pop_back();
+        return true;
+    }
+
+    // transport offsets of passengers, stored per coordinate so transforming them all
+    // compiles to packed float math with the transport's rotation computed only once
+    struct PassengerPositionBatch
+    {
+        std::vector<WorldObject*> Passengers;
+        std::vector<float> X, Y, Z, O;
+
+        void Clear()
+        {
+            Passengers.clear();
+            X.clear(); Y.clear(); Z.clear(); O.clear();
+        }
+
+        void AddRow(Position const& offset)
+        {
+            X.push_back(offset.GetPositionX());
+            Y.push_back(offset.GetPositionY());
+            Z.push_back(offset.GetPositionZ());
+            O.push_back(offset.GetOrientation());
+        }
+
+        void Transform(float transX, float transY, float transZ, float transO)
+        {
+            float const cosO = std::cos(transO);
+            float const sinO = std::sin(transO);
+            std::size_t const count = X.size();
+            float* x = X.data();
+            float* y = Y.data();
+            float* z = Z.data();
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                float const inx = x[i];
+                float const iny = y[i];
+                x[i] = transX + inx * cosO - iny * sinO;
+                y[i] = transY + iny * cosO + inx * sinO;
+                z[i] += transZ;
+            }
+
+            for (float& o : O)
+                o = Position::NormalizeOrientation(transO + o);
+        }
+    };
+
+    thread_local PassengerPositionBatch PassengerBatch;
+}
+
 void TransportBase::UpdatePassengerPosition(Map* map, WorldObject* passenger, float x, float y, float z, float o, bool setHomePosition)
 {
     // transport teleported but passenger not yet (can happen for players)
@@ -83,7 +143,7 @@ void TransportBase::UpdatePassengerPosition(Map* map, WorldObject* passenger, fl
 
 Transport::Transport() : GameObject(),
     _transportInfo(nullptr), _movementState(TransportMovementState::Moving), _eventsToTrigger(std::make_unique<boost::dynamic_bitset<uint8>>()),
-    _currentPathLeg(0), _pathProgress(0), _delayedAddModel(false)
+    _currentPathLeg(0), _pathProgress(0), _passengerPositionsOutdated(false), _delayedAddModel(false)
 {
     m_updateFlag = UPDATEFLAG_TRANSPORT | UPDATEFLAG_LOWGUID | UPDATEFLAG_STATIONARY_POSITION | UPDATEFLAG_ROTATION;
 }
@@ -260,6 +320,13 @@ void Transport::Update(uint32 diff)
                     // 4. - if transports stopped on grid edge, some passengers can remain in active grids
                     //      unload all static passengers otherwise passengers won't load correctly when the grid that transport is currently in becomes active
                     UnloadStaticPassengers();
+                else if (_passengerPositionsOutdated && GetMap()->IsGridActive(GetPositionX(), GetPositionY()))
+                {
+                    // players came near while stopped, move passengers left behind to where the transport stopped
+                    UpdatePassengerPositions(_passengers, true);
+                    UpdatePassengerPositions(_staticPassengers, true);
+                    _passengerPositionsOutdated = false;
+                }
             }
         }
     }
@@ -277,8 +344,9 @@ void Transport::AddPassenger(WorldObject* passenger)
     if (!IsInWorld())
         return;
 
-    if (_passengers.insert(passenger).second)
+    if (std::find(_passengers.begin(), _passengers.end(), passenger) == _passengers.end())
     {
+        _passengers.push_back(passenger);
         passenger->SetTransport(this);
         passenger->m_movementInfo.transport.guid = GetGUID();
         LOG_DEBUG("entities.transport", "Object %s boarded transport %s.", passenger->GetName().c_str(), GetName().c_str());
@@ -290,7 +358,7 @@ void Transport::AddPassenger(WorldObject* passenger)
 
 Transport* Transport::RemovePassenger(WorldObject* passenger)
 {
-    if (_passengers.erase(passenger) || _staticPassengers.erase(passenger)) // static passenger can remove itself in case of grid unload
+    if (ErasePassenger(_passengers, passenger) || ErasePassenger(_staticPassengers, passenger)) // static passenger can remove itself in case of grid unload
     {
         passenger->SetTransport(nullptr);
         passenger->m_movementInfo.transport.Reset();
@@ -351,7 +419,7 @@ Creature* Transport::CreateNPCPassenger(ObjectGuid::LowType guid, CreatureData c
         return nullptr;
     }
 
-    _staticPassengers.insert(creature);
+    _staticPassengers.push_back(creature);
     sScriptMgr->OnAddCreaturePassenger(this, creature);
     return creature;
 }
@@ -398,7 +466,7 @@ GameObject* Transport::CreateGOPassenger(ObjectGuid::LowType guid, GameObjectDat
         return nullptr;
     }
 
-    _staticPassengers.insert(go);
+    _staticPassengers.push_back(go);
     return go;
 }
 
@@ -507,7 +575,7 @@ TempSummon* Transport::SummonPassenger(uint32 entry, Position const& pos, TempSu
         return nullptr;
     }
 
-    _staticPassengers.insert(summon);
+    _staticPassengers.push_back(summon);
 
     summon->InitSummon();
     summon->SetTempSummonType(summonType);
@@ -531,7 +599,9 @@ void Transport::UpdatePosition(float x, float y, float z, float o)
     m_stationaryPosition.SetOrientation(o);
     UpdateModelPosition();
 
-    UpdatePassengerPositions(_passengers);
+    // passengers out of sight of every player only follow once someone comes near, players always do
+    bool observed = GetMap()->IsGridActive(x, y);
+    UpdatePassengerPositions(_passengers, observed);
 
     /* There are four possible scenarios that trigger loading/unloading passengers:
       1. transport moves from inactive to active grid
@@ -544,8 +614,10 @@ void Transport::UpdatePosition(float x, float y, float z, float o)
     else if (!_staticPassengers.empty() && !newActive && oldCell.DiffGrid(Cell(GetPositionX(), GetPositionY()))) // 3.
         UnloadStaticPassengers();
     else
-        UpdatePassengerPositions(_staticPassengers);
+        UpdatePassengerPositions(_staticPassengers, observed);
     // 4. is handed by grid unload
+
+    _passengerPositionsOutdated = !observed;
 }
 
 void Transport::LoadStaticPassengers()
@@ -690,15 +762,46 @@ void Transport::TeleportPassengersAndHideTransport(uint32 newMapid, float x, flo
     }
 }
 
-void Transport::UpdatePassengerPositions(PassengerSet const& passengers)
+void Transport::UpdatePassengerPositions(PassengerSet const& passengers, bool observed)
 {
+    // gather offsets first, relocation may add or remove passengers
+    // the batch is taken out of the thread's cache so nested updates can't clobber it
+    PassengerPositionBatch batch;
+    std::swap(batch, PassengerBatch);
+    batch.Clear();
     for (WorldObject* passenger : passengers)
     {
-        float x, y, z, o;
-        passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
-        CalculatePassengerPosition(x, y, z, &o);
-        UpdatePassengerPosition(GetMap(), passenger, x, y, z, o, true);
+        if (!observed && passenger->GetTypeId() != TYPEID_PLAYER)
+            continue;
+
+        batch.Passengers.push_back(passenger);
+        batch.AddRow(passenger->m_movementInfo.transport.pos);
+        // creatures also have their home position on the transport moved along, in the row following their position
+        if (Creature const* creature = passenger->ToCreature())
+            batch.AddRow(creature->GetTransportHomePosition());
+    }
+
+    if (!batch.Passengers.empty())
+    {
+        batch.Transform(GetPositionX(), GetPositionY(), GetPositionZ(), GetTransportOrientation());
+
+        // Map relocation only moves objects between grid cells when they cross one, otherwise they are relocated in place
+        std::size_t row = 0;
+        for (WorldObject* passenger : batch.Passengers)
+        {
+            UpdatePassengerPosition(GetMap(), passenger, batch.X[row], batch.Y[row], batch.Z[row], batch.O[row], false);
+            ++row;
+
+            if (Creature* creature = passenger->ToCreature())
+            {
+                if (passenger->GetMap() == GetMap())
+                    creature->SetHomePosition(batch.X[row], batch.Y[row], batch.Z[row], batch.O[row]);
+                ++row;
+            }
+        }
     }
+
+    std::swap(batch, PassengerBatch);
 }
 
 void Transport::BuildUpdate(UpdateDataMapType& data_map)
@@ -33,7 +33,8 @@ class FC_GAME_API Transport : public GameObject, public TransportBase
 
         Transport();
     public:
-        typedef std::set<WorldObject*> PassengerSet;
+        // passengers are few and walked on every position update, keep them contiguous
+        typedef std::vector<WorldObject*> PassengerSet;
 
         ~Transport();
 
@@ -110,7 +111,7 @@ class FC_GAME_API Transport : public GameObject, public TransportBase
         bool TeleportTransport(uint32 oldMapId, uint32 newMapId, float x, float y, float z, float o);
         void TeleportPassengersAndHideTransport(uint32 newMapid, float x, float y, float z, float o);
         void DelayedTeleportTransport();
-        void UpdatePassengerPositions(PassengerSet const& passengers);
+        void UpdatePassengerPositions(PassengerSet const& passengers, bool observed);
 
         TransportTemplate const* _transportInfo;
         TransportMovementState _movementState;
@@ -121,8 +122,8 @@ class FC_GAME_API Transport : public GameObject, public TransportBase
         TimeTrackerSmall _positionChangeTimer;
 
         PassengerSet _passengers;
-        PassengerSet::iterator _passengerTeleportItr;
         PassengerSet _staticPassengers;
+        bool _passengerPositionsOutdated;               // non player passengers were left behind while no player was near
 
         bool _delayedAddModel;
 };
@@ -63,6 +63,7 @@
 #include "PhasingHandler.h"
 #include "Player.h"
 #include "PlayerAI.h"
+#include "Profiler.h"
 #include "QuestDef.h"
 #include "ReputationMgr.h"
 #include "ScheduledChangeAI.h"
@@ -717,6 +718,9 @@ bool Unit::HasBreakableByDamageCrowdControlAura(Unit* excludeCasterChannel) cons
     // Sparring Checks
     if (Creature* target = victim->ToCreature())
     {
+        // a creature taking damage must react on this tick, not when its update tier comes due
+        target->WakeUpdate();
+
         if (attacker->IsCreature() && !attacker->IsCharmedOwnedByPlayerOrPlayer())
         {
             if (target->GetNoNpcDamageBelowPctHealthValue() != 0.0f)
@@ -2828,6 +2832,8 @@ void Unit::_DeleteRemovedAuras()
 
 void Unit::_UpdateSpells(uint32 time)
 {
+    FC_PROFILE_ZONE("Unit::UpdateSpells");
+
     if (m_currentSpells[CURRENT_AUTOREPEAT_SPELL])
         _UpdateAutoRepeatSpell();
 
@@ -10309,6 +10315,7 @@ void Unit::AIUpdateTick(uint32 diff)
 {
     if (UnitAI* ai = GetAI())
     {
+        FC_PROFILE_ZONE("UnitAI::UpdateAI");
         m_aiLocked = true;
         ai->UpdateAI(diff);
         m_aiLocked = false;
@@ -14642,135 +14649,135 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (IsCreature())
         visibleFlag |= UF_FLAG_UNIT_ALL;
 
+    thread_local FieldBitset fields;
+    SelectValuesUpdateFields(fields, updateType, flags, visibleFlag, _fieldNotifyFlags | (visibleFlag & UF_FLAG_SPECIAL_INFO), valCount);
+    if (HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+        fields.Set(UNIT_FIELD_AURASTATE);
+
     Creature const* creature = ToCreature();
-    for (uint16 index = 0; index < valCount; ++index)
+    for (uint32 index = fields.FindNext(0); index < valCount; index = fields.FindNext(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] || ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK)))
+        updateMask.SetBit(index);
+
+        if (index == UNIT_NPC_FLAGS)
         {
-            updateMask.SetBit(index);
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
 
-            if (index == UNIT_NPC_FLAGS)
+            if (creature)
             {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+                if (!target->CanSeeSpellClickOn(creature))
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                if (creature)
-                {
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+                if (!creature->IsClassTrainerOf(target))
+                    appendValue &= ~UNIT_NPC_FLAG_TRAINER_CLASS;
+            }
 
-                    if (!creature->IsClassTrainerOf(target))
-                        appendValue &= ~UNIT_NPC_FLAG_TRAINER_CLASS;
-                }
+            fieldBuffer << uint32(appendValue);
+        }
+        else if (index == UNIT_FIELD_AURASTATE)
+        {
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            fieldBuffer << BuildAuraStateUpdateForTarget(target);
+        }
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
+        // there are some float values which may be negative or can't get negative due to other checks
+        else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) || (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                 (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) || (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+        {
+            fieldBuffer << uint32(m_floatValues[index]);
+        }
+        // Gamemasters should be always able to select units - remove not selectable flag
+        else if (index == UNIT_FIELD_FLAGS)
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster())
+                appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
 
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
-            }
-            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-            {
-                // convert from float to uint32 and send
-                fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-            }
-            // there are some float values which may be negative or can't get negative due to other checks
-            else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) || (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) || (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-            {
-                fieldBuffer << uint32(m_floatValues[index]);
-            }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
+            fieldBuffer << uint32(appendValue);
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        else if (index == UNIT_FIELD_DISPLAYID)
+        {
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                fieldBuffer << uint32(appendValue);
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                        if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
+
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                    if (target->IsGameMaster())
+                        displayId = cinfo->GetFirstVisibleModel();
             }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
+
+            fieldBuffer << uint32(displayId);
+        }
+        // hide lootable animation for unallowed players
+        else if (index == UNIT_DYNAMIC_FLAGS)
+        {
+            uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+
+            if (creature)
             {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
+                if (creature->hasLootRecipient())
                 {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
-
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
-
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                        if (target->IsGameMaster())
-                            displayId = cinfo->GetFirstVisibleModel();
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
 
-                fieldBuffer << uint32(displayId);
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
             }
-            // hide lootable animation for unallowed players
-            else if (index == UNIT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                }
-
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-
-                fieldBuffer << dynamicFlags;
-            }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+            fieldBuffer << dynamicFlags;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+        {
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
             {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(ft2))
                 {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] &
-                                            ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont
-                            // work)
-                            fieldBuffer << uint32(target->GetFaction());
-                    }
+                    if (index == UNIT_FIELD_BYTES_2)
+                        // Allow targetting opposite faction in party when enabled in config
+                        fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] &
+                                        ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
                     else
-                        fieldBuffer << m_uint32Values[index];
+                        // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont
+                        // work)
+                        fieldBuffer << uint32(target->GetFaction());
                 }
                 else
                     fieldBuffer << m_uint32Values[index];
             }
             else
-            {
-                // send in current format (float as float, uint32 as uint32)
                 fieldBuffer << m_uint32Values[index];
-            }
+        }
+        else
+        {
+            // send in current format (float as float, uint32 as uint32)
+            fieldBuffer << m_uint32Values[index];
         }
     }
 
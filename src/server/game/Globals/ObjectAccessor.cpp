@@ -39,6 +39,7 @@ void HashMapHolder<T>::Insert(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+    GetIndex().Insert(o->GetGUID(), o);
 }
 
 template<class T>
@@ -47,15 +48,13 @@ void HashMapHolder<T>::Remove(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+    GetIndex().Remove(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    return GetIndex().Find(guid);
 }
 
 template<class T>
@@ -72,6 +71,13 @@ std::shared_mutex* HashMapHolder<T>::GetLock()
     return &_lock;
 }
 
+template<class T>
+auto HashMapHolder<T>::GetIndex() -> IndexType&
+{
+    static IndexType _objectIndex;
+    return _objectIndex;
+}
+
 HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
 {
     return HashMapHolder<Player>::GetContainer();
@@ -81,17 +87,17 @@ template class FC_GAME_API HashMapHolder<Player>;
 
 namespace PlayerNameMapHolder
 {
-typedef std::unordered_map<std::string, Player*> MapType;
+typedef ShardedHashMap<std::string, Player*> MapType;
 static MapType PlayerNameMap;
 
 void Insert(Player* p)
 {
-    PlayerNameMap[p->GetName()] = p;
+    PlayerNameMap.Insert(p->GetName(), p);
 }
 
 void Remove(Player* p)
 {
-    PlayerNameMap.erase(p->GetName());
+    PlayerNameMap.Remove(p->GetName());
 }
 
 Player* Find(std::string const& name)
@@ -100,8 +106,7 @@ Player* Find(std::string const& name)
     if (!normalizePlayerName(charName))
         return nullptr;
 
-    auto itr = PlayerNameMap.find(charName);
-    return (itr != PlayerNameMap.end()) ? itr->second : nullptr;
+    return PlayerNameMap.Find(charName);
 }
 } // namespace PlayerNameMapHolder
 
@@ -19,6 +19,7 @@
 #define FIRELANDS_OBJECTACCESSOR_H
 
 #include "ObjectGuid.h"
+#include "ShardedHashMap.h"
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -44,16 +45,22 @@ class FC_GAME_API HashMapHolder
 
 public:
     typedef std::unordered_map<ObjectGuid, T*> MapType;
+    typedef ShardedHashMap<ObjectGuid, T*> IndexType;
 
     static void Insert(T* o);
 
     static void Remove(T* o);
 
+    // only locks the shard of guid, not GetLock()
     static T* Find(ObjectGuid guid);
 
+    // kept for iterating all objects, guarded by GetLock()
     static MapType& GetContainer();
 
     static std::shared_mutex* GetLock();
+
+private:
+    static IndexType& GetIndex();
 };
 
 namespace ObjectAccessor
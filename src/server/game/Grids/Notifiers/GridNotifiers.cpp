@@ -133,6 +133,9 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
     if (!u->IsAlive() || !c->IsAlive() || c == u || u->IsInFlight())
         return;
 
+    if (u->GetTypeId() == TYPEID_PLAYER && c->IsWithinDist(u, CREATURE_UPDATE_WAKE_DISTANCE))
+        c->WakeUpdate();
+
     if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
     {
         if (c->IsAIEnabled() && c->CanSeeOrDetect(u, false, true))
@@ -408,6 +411,26 @@ void ObjectUpdater::Visit(GridRefManager<T> &m)
             iter->GetSource()->Update(i_timeDiff);
 }
 
+void ObjectUpdater::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Creature* creature = iter->GetSource();
+        if (!creature->IsInWorld())
+            continue;
+
+        // reading the clock for every creature would cost more than some of the updates
+        if (i_creatureUpdateDeadline && !i_overBudget && !(++i_creatureVisits % 16))
+            i_overBudget = std::chrono::steady_clock::now() >= *i_creatureUpdateDeadline;
+
+        uint32 diff;
+        if (creature->IsUpdateDue(i_timeDiff, i_overBudget, diff))
+            creature->Update(diff);
+        else if (i_overBudget)
+            ++i_deferredCreatures;
+    }
+}
+
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
 {
     return !u->IsAlive() && !u->HasAuraType(SPELL_AURA_GHOST) && i_searchObj->IsWithinDistInMap(u, i_range);
@@ -438,7 +461,6 @@ bool AnyDeadUnitSpellTargetInRangeCheck::operator()(Creature* u)
     return AnyDeadUnitObjectInRangeCheck::operator()(u) && i_check(u);
 }
 
-template void ObjectUpdater::Visit<Creature>(CreatureMapType&);
 template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
 template void ObjectUpdater::Visit<AreaTrigger>(AreaTriggerMapType &);
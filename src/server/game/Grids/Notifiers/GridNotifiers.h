@@ -120,6 +120,7 @@ namespace Firelands
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
@@ -133,6 +134,13 @@ namespace Firelands
                     team = player->GetTeam();
         }
 
+        // receivers reference the payload of msg instead of copying it
+        MessageDistDeliverer(WorldObject const* src, std::shared_ptr<WorldPacket const> msg, float dist)
+            : MessageDistDeliverer(src, msg.get(), dist)
+        {
+            i_sharedMessage = std::move(msg);
+        }
+
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
         void Visit(DynamicObjectMapType &m);
@@ -147,7 +155,10 @@ namespace Firelands
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            if (i_sharedMessage)
+                player->SendDirectMessage(i_sharedMessage);
+            else
+                player->SendDirectMessage(i_message);
         }
     };
 
@@ -180,10 +191,22 @@ namespace Firelands
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff) { }
+        explicit ObjectUpdater(const uint32 diff) : i_timeDiff(diff), i_creatureVisits(0), i_deferredCreatures(0), i_overBudget(false) { }
         template<class T> void Visit(GridRefManager<T> &m);
+        void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &) { }
         void Visit(CorpseMapType &) { }
+
+        // once creature updates of this tick run past the budget only creatures in the active update tier are updated
+        void SetCreatureUpdateBudget(Milliseconds budget) { i_creatureUpdateDeadline = std::chrono::steady_clock::now() + budget; }
+        bool IsOverCreatureUpdateBudget() const { return i_overBudget; }
+        uint32 GetDeferredCreatureCount() const { return i_deferredCreatures; }
+
+    private:
+        Optional<std::chrono::steady_clock::time_point> i_creatureUpdateDeadline;
+        uint32 i_creatureVisits;
+        uint32 i_deferredCreatures;
+        bool i_overBudget;
     };
 
     // SEARCHERS & LIST SEARCHERS & WORKERS
@@ -45,6 +45,7 @@
 
 #define MAX_GUILD_BANK_TAB_TEXT_LEN 500
 #define EMBLEM_PRICE 10 * GOLD
+#define GUILD_ROSTER_CACHE_LIFETIME 60 // seconds, offline members keep aging in the cached roster
 
 std::string _GetGuildEventString(GuildEvents event)
 {
@@ -569,8 +570,9 @@ void Guild::BankTab::SendText(Guild const* guild, WorldSession* session) const
 }
 
 // Member
-Guild::Member::Member(ObjectGuid::LowType guildId, ObjectGuid guid, uint8 rankId) :
-    m_guildId(guildId),
+Guild::Member::Member(Guild* guild, ObjectGuid guid, uint8 rankId) :
+    m_guild(guild),
+    m_guildId(guild->GetId()),
     m_guid(guid),
     m_zoneId(0),
     m_level(0),
@@ -600,6 +602,7 @@ void Guild::Member::SetStats(Player* player)
     m_accountId = player->GetSession()->GetAccountId();
     m_achievementPoints = player->GetAchievementPoints();
     m_totalReputation = player->GetReputation(FACTION_GUILD);
+    m_guild->_InvalidateRoster();
 }
 
 void Guild::Member::SetStats(std::string const& name, uint8 level, uint8 _class, uint32 zoneId, uint32 accountId, uint32 achievementPoints, uint32 reputation)
@@ -611,6 +614,7 @@ void Guild::Member::SetStats(std::string const& name, uint8 level, uint8 _class,
     m_accountId = accountId;
     m_achievementPoints = achievementPoints;
     m_totalReputation = reputation;
+    m_guild->_InvalidateRoster();
 }
 
 void Guild::Member::SetPublicNote(std::string const& publicNote)
@@ -619,6 +623,7 @@ void Guild::Member::SetPublicNote(std::string const& publicNote)
         return;
 
     m_publicNote = publicNote;
+    m_guild->_InvalidateRoster();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_PNOTE);
     stmt->setString(0, publicNote);
@@ -632,6 +637,7 @@ void Guild::Member::SetOfficerNote(std::string const& officerNote)
         return;
 
     m_officerNote = officerNote;
+    m_guild->_InvalidateRoster();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_OFFNOTE);
     stmt->setString(0, officerNote);
@@ -642,6 +648,7 @@ void Guild::Member::SetOfficerNote(std::string const& officerNote)
 void Guild::Member::ChangeRank(CharacterDatabaseTransaction& trans, uint8 newRank)
 {
     m_rankId = newRank;
+    m_guild->_InvalidateRoster();
 
     // Update rank information in player's field, if he is online.
     if (Player* player = FindConnectedPlayer())
@@ -657,6 +664,7 @@ void Guild::Member::AddActivity(uint64 activity)
 {
     m_totalActivity += activity;
     m_weekActivity += activity;
+    m_guild->_InvalidateRoster();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_ACTIVITY);
     stmt->setUInt64(0, m_totalActivity);
@@ -812,6 +820,7 @@ Player* Guild::Member::FindConnectedPlayer() const
 void Guild::Member::UpdateLogoutTime()
 {
     m_logoutTime = ::GameTime::GetGameTime();
+    m_guild->_InvalidateRoster();
 }
 
 // Decreases amount of slots left for today.
@@ -860,6 +869,7 @@ void Guild::Member::AddReputation(uint32 rep, Player *player)
 
     m_weekReputation += rep;
     m_totalReputation = player->GetReputation(FACTION_GUILD);
+    m_guild->_InvalidateRoster();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_WEEK_REPUTATION);
     stmt->setUInt32(0, m_weekReputation);
@@ -871,6 +881,7 @@ void Guild::Member::ResetWeekActivityAndReputation()
 {
     m_weekActivity = 0;
     m_weekReputation = 0;
+    m_guild->_InvalidateRoster();
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -891,6 +902,8 @@ void Guild::Member::UpdateProfessionData()
     if (!player)
         return;
 
+    m_guild->_InvalidateRoster();
+
     for (uint8 i = 0; i < GUILD_PROFESSION_COUNT; i++)
     {
         uint32 skillId = player->GetUInt32Value(PLAYER_PROFESSION_SKILL_LINE_1 + i);
@@ -1295,7 +1308,10 @@ Guild::Guild():
     m_newsLog(nullptr),
     _level(1),
     _experience(0),
-    _todayExperience(0)
+    _todayExperience(0),
+    m_rosterVersion(0),
+    m_rosterPacketVersion(0),
+    m_rosterPacketTime(0)
 {
     memset(&m_bankEventLog, 0, (GUILD_BANK_MAX_TABS + 1) * sizeof(LogHolder*));
 
@@ -1519,7 +1535,22 @@ bool Guild::SetName(std::string const& name)
 
 void Guild::HandleRoster(WorldSession* session)
 {
-     WorldPackets::Guild::GuildRoster roster;
+    uint32 rosterVersion = m_rosterVersion.load(std::memory_order_relaxed);
+    time_t now = ::GameTime::GetGameTime();
+    if (!m_rosterPacket || m_rosterPacketVersion != rosterVersion || now - m_rosterPacketTime >= GUILD_ROSTER_CACHE_LIFETIME)
+    {
+        m_rosterPacket = std::make_shared<WorldPacket const>(_BuildRoster());
+        m_rosterPacketVersion = rosterVersion;
+        m_rosterPacketTime = now;
+    }
+
+    LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s]", session->GetPlayerInfo().c_str());
+    session->SendPacket(m_rosterPacket);
+}
+
+WorldPacket Guild::_BuildRoster() const
+{
+    WorldPackets::Guild::GuildRoster roster;
 
     roster.NumAccounts = int32(m_accountsNumber);
     roster.CreateDate = uint32(m_createdDate);
@@ -1571,8 +1602,8 @@ void Guild::HandleRoster(WorldSession* session)
     roster.WelcomeText = m_motd;
     roster.InfoText = m_info;
 
-    LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s]", session->GetPlayerInfo().c_str());
-    session->SendPacket(roster.Write());
+    roster.Write();
+    return roster.Move();
 }
 
 void Guild::SendQueryResponse(WorldSession* session)
@@ -1674,6 +1705,7 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string const& motd)
     else
     {
         m_motd = motd;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildMOTDChanged(this, motd);
 
@@ -1695,6 +1727,7 @@ void Guild::HandleSetInfo(WorldSession* session, std::string const& info)
     if (_HasRankRight(session->GetPlayer(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildInfoChanged(this, info);
 
@@ -2573,7 +2606,7 @@ bool Guild::LoadMemberFromDB(Field* fields)
 {
     ObjectGuid::LowType lowguid = fields[1].GetUInt32();
     ObjectGuid playerGuid(HighGuid::Player, lowguid);
-    Member* member = new Member(m_id, playerGuid, fields[2].GetUInt8());
+    Member* member = new Member(this, playerGuid, fields[2].GetUInt8());
     if (!member->LoadFromDB(fields))
     {
         CharacterDatabaseTransaction trans(nullptr);
@@ -2584,6 +2617,7 @@ bool Guild::LoadMemberFromDB(Field* fields)
 
     sCharacterCache->UpdateCharacterGuildId(playerGuid, GetId());
     m_members[lowguid] = member;
+    _InvalidateRoster();
     return true;
 }
 
@@ -2884,7 +2918,7 @@ bool Guild::AddMember(CharacterDatabaseTransaction& trans, ObjectGuid guid, uint
     if (rankId == GUILD_RANK_NONE)
         rankId = _GetLowestRankId();
 
-    Member* member = new Member(m_id, guid, rankId);
+    Member* member = new Member(this, guid, rankId);
     std::string name;
 
     /* Check if player can keep his guild reputation */
@@ -2908,6 +2942,7 @@ bool Guild::AddMember(CharacterDatabaseTransaction& trans, ObjectGuid guid, uint
             player->SetReputation(FACTION_GUILD, 0);
 
         m_members[lowguid] = member;
+        _InvalidateRoster();
         player->SetInGuild(m_id);
         player->SetGuildIdInvited(0);
         player->SetGuildRank(rankId);
@@ -2958,6 +2993,7 @@ bool Guild::AddMember(CharacterDatabaseTransaction& trans, ObjectGuid guid, uint
         }
 
         m_members[lowguid] = member;
+        _InvalidateRoster();
         sCharacterCache->UpdateCharacterGuildId(guid, GetId());
     }
 
@@ -3036,6 +3072,7 @@ void Guild::DeleteMember(CharacterDatabaseTransaction& trans, ObjectGuid guid, b
         delete member;
     }
     m_members.erase(lowguid);
+    _InvalidateRoster();
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
@@ -3211,6 +3248,7 @@ void Guild::_UpdateAccountsNumber()
         accountsIdSet.insert(itr->second->GetAccountId());
 
     m_accountsNumber = accountsIdSet.size();
+    _InvalidateRoster();
 }
 
 // Detects if player is the guild master.
@@ -3613,12 +3651,22 @@ void Guild::_SendBankContentUpdate(uint8 tabId, SlotIds slots) const
             packet.ItemInfo.push_back(itemInfo);
         }
 
+        // remaining withdrawals are the only per member data, serialize once for each distinct value
+        std::map<int32, std::shared_ptr<WorldPacket const>> packets;
         for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
             if (_MemberHasTabRights(itr->second->GetGUID(), tabId, GUILD_BANK_RIGHT_VIEW_TAB))
                 if (Player* player = itr->second->FindPlayer())
                 {
-                    packet.WithdrawalsRemaining = _GetMemberRemainingSlots(itr->second, tabId);
-                    player->GetSession()->SendPacket(packet.Write());
+                    int32 withdrawalsRemaining = _GetMemberRemainingSlots(itr->second, tabId);
+                    std::shared_ptr<WorldPacket const>& memberPacket = packets[withdrawalsRemaining];
+                    if (!memberPacket)
+                    {
+                        packet.Clear();
+                        packet.WithdrawalsRemaining = withdrawalsRemaining;
+                        memberPacket = std::make_shared<WorldPacket const>(*packet.Write());
+                    }
+
+                    player->GetSession()->SendPacket(memberPacket);
                 }
     }
 }
@@ -23,6 +23,8 @@
 #include "SharedDefines.h"
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 
 template<class T>
@@ -349,7 +351,7 @@ private:
     class Member
     {
     public:
-        Member(ObjectGuid::LowType guildId, ObjectGuid guid, uint8 rankId);
+        Member(Guild* guild, ObjectGuid guid, uint8 rankId);
 
         void SetStats(Player* player);
         void SetStats(std::string const& name, uint8 level, uint8 _class, uint32 zoneId, uint32 accountId, uint32 achievementPoints, uint32 reputation);
@@ -357,17 +359,17 @@ private:
 
         void SetPublicNote(std::string const& publicNote);
         void SetOfficerNote(std::string const& officerNote);
-        void SetZoneId(uint32 id) { m_zoneId = id; }
-        void SetAchievementPoints(uint32 val) { m_achievementPoints = val; }
-        void SetLevel(uint8 var) { m_level = var; }
+        void SetZoneId(uint32 id) { m_zoneId = id; m_guild->_InvalidateRoster(); }
+        void SetAchievementPoints(uint32 val) { m_achievementPoints = val; m_guild->_InvalidateRoster(); }
+        void SetLevel(uint8 var) { m_level = var; m_guild->_InvalidateRoster(); }
         void AddActivity(uint64 activity);
-        void SetWeekReputation(uint32 reputation) { m_weekReputation = reputation; }
+        void SetWeekReputation(uint32 reputation) { m_weekReputation = reputation; m_guild->_InvalidateRoster(); }
         void AddReputation(uint32 rep, Player *player);
         void UpdateProfessionData();
 
-        void AddFlag(uint8 var) { m_flags |= var; }
-        void RemFlag(uint8 var) { m_flags &= ~var; }
-        void ResetFlags() { m_flags = GUILDMEMBER_STATUS_NONE; }
+        void AddFlag(uint8 var) { m_flags |= var; m_guild->_InvalidateRoster(); }
+        void RemFlag(uint8 var) { m_flags &= ~var; m_guild->_InvalidateRoster(); }
+        void ResetFlags() { m_flags = GUILDMEMBER_STATUS_NONE; m_guild->_InvalidateRoster(); }
 
         bool LoadFromDB(Field* fields);
         void LoadProfessionDataFromDB(ObjectGuid guid);
@@ -416,6 +418,7 @@ private:
         Player* FindConnectedPlayer() const;
 
     private:
+        Guild* m_guild;
         ObjectGuid::LowType m_guildId;
         // Fields from characters table
         ObjectGuid m_guid;
@@ -940,7 +943,17 @@ protected:
     uint32 _challengeGoldMaxLevel[MAX_GUILD_CHALLENGE_TYPES];
     uint32 _challengeXp[MAX_GUILD_CHALLENGE_TYPES];
 
+    // Serialized SMSG_GUILD_ROSTER shared by all roster requests until m_rosterVersion moves.
+    // Members change from map threads, so they only bump the atomic version.
+    std::atomic<uint32> m_rosterVersion;
+    uint32 m_rosterPacketVersion;
+    time_t m_rosterPacketTime;
+    std::shared_ptr<WorldPacket const> m_rosterPacket;
+
 private:
+    void _InvalidateRoster() { m_rosterVersion.fetch_add(1, std::memory_order_relaxed); }
+    WorldPacket _BuildRoster() const;
+
     inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
     inline const RankInfo* GetRankInfo(uint8 rankId) const { return rankId < _GetRanksSize() ? &m_ranks[rankId] : nullptr; }
     inline RankInfo* GetRankInfo(uint8 rankId) { return rankId < _GetRanksSize() ? &m_ranks[rankId] : nullptr; }
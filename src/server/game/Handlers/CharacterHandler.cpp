@@ -36,6 +36,7 @@
 #include "Item.h"
 #include "LFGMgr.h"
 #include "Language.h"
+#include "LatencyHistogram.h"
 #include "Log.h"
 #include "Map.h"
 #include "Metric.h"
@@ -64,15 +65,30 @@ class LoginQueryHolder : public CharacterDatabaseQueryHolder {
  private:
   uint32 m_accountId;
   ObjectGuid m_guid;
+  std::chrono::steady_clock::time_point m_startTime;
 
  public:
   LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-      : m_accountId(accountId), m_guid(guid) {}
+      : m_accountId(accountId),
+        m_guid(guid),
+        m_startTime(std::chrono::steady_clock::now()) {}
   ObjectGuid GetGuid() const { return m_guid; }
   uint32 GetAccountId() const { return m_accountId; }
+  uint64 GetElapsedMicroseconds() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - m_startTime)
+        .count();
+  }
   bool Initialize();
 };
 
+namespace {
+// from the login request until the character queries are back in the world
+// thread, and until the player is in the world
+LatencyHistogram LoginQueryLatency;
+LatencyHistogram LoginLatency;
+}  // namespace
+
 bool LoginQueryHolder::Initialize() {
   SetSize(MAX_PLAYER_LOGIN_QUERY);
 
@@ -140,13 +156,9 @@ bool LoginQueryHolder::Initialize() {
   stmt->setUInt32(0, lowGuid);
   res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_ACTIONS, stmt);
 
-  stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL);
-  stmt->setUInt32(0, lowGuid);
-  res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAILS, stmt);
-
-  stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+  stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL_SUMMARY);
   stmt->setUInt32(0, lowGuid);
-  res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS, stmt);
+  res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_SUMMARY, stmt);
 
   stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_SOCIALLIST);
   stmt->setUInt32(0, lowGuid);
@@ -836,9 +848,14 @@ void WorldSession::HandleContinuePlayerLogin() {
     return;
   }
 
-  AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder))
+  // the login statements are independent of each other, a reconnect wave
+  // after a restart must not pay for their round trips one by one
+  AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder, true))
       .AfterComplete([this](SQLQueryHolderBase const &holder) {
-        HandlePlayerLogin(static_cast<LoginQueryHolder const &>(holder));
+        LoginQueryHolder const &loginHolder =
+            static_cast<LoginQueryHolder const &>(holder);
+        LoginQueryLatency.Record(loginHolder.GetElapsedMicroseconds());
+        HandlePlayerLogin(loginHolder);
       });
 }
 
@@ -1255,9 +1272,31 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder const &holder) {
 
   sScriptMgr->OnPlayerLogin(pCurrChar, firstLogin);
 
+  LoginLatency.Record(holder.GetElapsedMicroseconds());
   FC_METRIC_EVENT("player_events", "Login", pCurrChar->GetName());
 }
 
+void WorldSession::LogLoginMetrics() {
+  auto logLatency = [](LatencyHistogram &histogram, char const *stage) {
+    if (!histogram.GetCount()) return;
+
+    LatencyHistogram::Snapshot latency = histogram.TakeSnapshot();
+    std::string tags = std::string(",stage=") + stage;
+    FC_METRIC_VALUE("player_login_count" + tags, latency.Count);
+    FC_METRIC_VALUE("player_login_latency_p50" + tags,
+                    latency.GetPercentile(50));
+    FC_METRIC_VALUE("player_login_latency_p95" + tags,
+                    latency.GetPercentile(95));
+    FC_METRIC_VALUE("player_login_latency_p99" + tags,
+                    latency.GetPercentile(99));
+    FC_METRIC_VALUE("player_login_latency_max" + tags,
+                    latency.MaxMicroseconds);
+  };
+
+  logLatency(LoginQueryLatency, "query");
+  logLatency(LoginLatency, "total");
+}
+
 void WorldSession::HandleSetFactionAtWar(WorldPacket &recvData) {
   LOG_DEBUG("network", "WORLD: Received CMSG_SET_FACTION_ATWAR");
 
@@ -32,6 +32,7 @@
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "Player.h"
+#include "QueryHolder.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -203,17 +204,18 @@ void WorldSession::HandleSendMail(WorldPacket &recvData) {
 
   if (receiver) {
     receiverTeam = receiver->GetTeam();
-    mailsCount = receiver->GetMailSize();
     receiverLevel = receiver->getLevel();
     receiverAccountId = receiver->GetSession()->GetAccountId();
-  } else {
-    if (CharacterCacheEntry const *characterInfo =
-            sCharacterCache->GetCharacterCacheByGuid(receiverGuid)) {
-      receiverTeam = Player::TeamForRace(characterInfo->Race);
-      receiverLevel = characterInfo->Level;
-      receiverAccountId = characterInfo->AccountId;
-    }
+  } else if (CharacterCacheEntry const *characterInfo =
+                 sCharacterCache->GetCharacterCacheByGuid(receiverGuid)) {
+    receiverTeam = Player::TeamForRace(characterInfo->Race);
+    receiverLevel = characterInfo->Level;
+    receiverAccountId = characterInfo->AccountId;
+  }
 
+  if (receiver && receiver->GetMailboxState() == MAILBOX_LOADED)
+    mailsCount = receiver->GetMailSize();
+  else {
     CharacterDatabasePreparedStatement *stmt =
         CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL_COUNT);
     stmt->setUInt32(0, receiverGuid.GetCounter());
@@ -223,7 +225,6 @@ void WorldSession::HandleSendMail(WorldPacket &recvData) {
       Field *fields = result->Fetch();
       mailsCount = fields[0].GetUInt64();
     }
-
   }
 
   // do not allow to have more than 100 mails in mailbox.. mails count is in
@@ -659,6 +660,51 @@ void WorldSession::HandleGetMailList(WorldPacket &recvData) {
   if (!CanOpenMailBox(mailbox))
     return;
 
+  switch (_player->GetMailboxState()) {
+  case MAILBOX_LOADED:
+    SendMailList(mailbox);
+    break;
+  case MAILBOX_NOT_LOADED:
+    // the mailbox is loaded on first use, the list is sent once it is back
+    LoadMailbox([this, mailbox]() {
+      if (CanOpenMailBox(mailbox))
+        SendMailList(mailbox);
+    });
+    break;
+  case MAILBOX_LOADING:
+    break;
+  }
+}
+
+void WorldSession::LoadMailbox(std::function<void()> onLoaded) {
+  std::shared_ptr<CharacterDatabaseQueryHolder> holder =
+      std::make_shared<CharacterDatabaseQueryHolder>();
+  holder->SetSize(2);
+
+  CharacterDatabasePreparedStatement *stmt =
+      CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL);
+  stmt->setUInt32(0, _player->GetGUID().GetCounter());
+  holder->SetPreparedQuery(0, stmt);
+
+  stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+  stmt->setUInt32(0, _player->GetGUID().GetCounter());
+  holder->SetPreparedQuery(1, stmt);
+
+  _player->m_mailboxState = MAILBOX_LOADING;
+  AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder))
+      .AfterComplete([this, playerGuid = _player->GetGUID(),
+                      onLoaded = std::move(onLoaded)](
+                         SQLQueryHolderBase const &result) {
+        if (!_player || _player->GetGUID() != playerGuid)
+          return;
+
+        _player->_LoadMail(result.GetPreparedResult(0),
+                           result.GetPreparedResult(1));
+        onLoaded();
+      });
+}
+
+void WorldSession::SendMailList(ObjectGuid mailbox) {
   Player *player = _player;
 
   // client can't work with packets > max int16 value
@@ -840,7 +886,66 @@ void WorldSession::HandleMailCreateTextItem(WorldPacket &recvData) {
   }
 }
 
+static void BuildNextMailTimeEntry(WorldPacket &data, uint8 messageType,
+                                   uint32 sender, uint8 stationery,
+                                   time_t deliverTime, time_t now) {
+  data << uint64(messageType == MAIL_NORMAL
+                     ? ObjectGuid(HighGuid::Player, sender)
+                     : ObjectGuid::Empty);             // player guid
+  data << uint32(messageType != MAIL_NORMAL ? sender : 0); // non-player entries
+  data << uint32(messageType);
+  data << uint32(stationery);
+  data << float(deliverTime - now);
+}
+
 void WorldSession::HandleQueryNextMailTime(WorldPacket & /*recvData*/) {
+  if (_player->unReadMails == 0 ||
+      _player->GetMailboxState() == MAILBOX_LOADED) {
+    SendQueryNextMailTime();
+    return;
+  }
+
+  // the mailbox is only loaded for the mail list, the two mails shown here are
+  // read straight from the database
+  CharacterDatabasePreparedStatement *stmt =
+      CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL_NEXT_TIME);
+  stmt->setUInt32(0, _player->GetGUID().GetCounter());
+  stmt->setUInt32(1, uint32(GameTime::GetGameTime()));
+  _queryProcessor.AddCallback(
+      CharacterDatabase.AsyncQuery(stmt).WithPreparedCallback(
+          [this, playerGuid = _player->GetGUID()](PreparedQueryResult result) {
+            if (!_player || _player->GetGUID() != playerGuid)
+              return;
+
+            WorldPacket data(MSG_QUERY_NEXT_MAIL_TIME, 8);
+            data << float(0);  // float
+            data << uint32(0); // count
+
+            uint32 count = 0;
+            if (result) {
+              time_t now = GameTime::GetGameTime();
+              uint32 sentSender = 0;
+              do {
+                Field *fields = result->Fetch();
+                uint32 sender = fields[0].GetUInt32();
+                // only send each mail sender once
+                if (count && sender == sentSender)
+                  continue;
+
+                BuildNextMailTimeEntry(data, fields[1].GetUInt8(), sender,
+                                       fields[2].GetUInt8(),
+                                       time_t(fields[3].GetUInt32()), now);
+                sentSender = sender;
+                ++count;
+              } while (result->NextRow());
+            }
+
+            data.put<uint32>(4, count);
+            SendPacket(&data);
+          }));
+}
+
+void WorldSession::SendQueryNextMailTime() {
   WorldPacket data(MSG_QUERY_NEXT_MAIL_TIME, 8);
 
   if (_player->unReadMails > 0) {
@@ -865,14 +970,8 @@ void WorldSession::HandleQueryNextMailTime(WorldPacket & /*recvData*/) {
       if (sentSenders.count(m->sender))
         continue;
 
-      data << uint64(m->messageType == MAIL_NORMAL
-                         ? ObjectGuid(HighGuid::Player, m->sender)
-                         : ObjectGuid::Empty); // player guid
-      data << uint32(m->messageType != MAIL_NORMAL ? m->sender
-                                                   : 0); // non-player entries
-      data << uint32(m->messageType);
-      data << uint32(m->stationery);
-      data << float(m->deliver_time - now);
+      BuildNextMailTimeEntry(data, m->messageType, m->sender, m->stationery,
+                             m->deliver_time, now);
 
       sentSenders.insert(m->sender);
       ++count;
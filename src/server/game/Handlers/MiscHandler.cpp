@@ -231,97 +231,38 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
     if (whoRequest.Request.MaxLevel >= MAX_LEVEL)
         whoRequest.Request.MaxLevel = STRONG_MAX_LEVEL;
 
-    uint32 team = _player->GetTeam();
-
-    uint32 gmLevelInWhoList = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+    WhoListQuery query;
+    query.MinLevel = request.MinLevel;
+    query.MaxLevel = request.MaxLevel;
+    query.ClassFilter = request.ClassFilter;
+    query.RaceFilter = request.RaceFilter;
+    query.Areas = request.Areas;
+    query.PlayerName = std::move(wPlayerName);
+    query.GuildName = std::move(wGuildName);
+    query.Words = std::move(wWords);
+    query.Team = HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST) ? 0 : _player->GetTeam();
+    query.MaxVisibleSecurity = HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS) ? SEC_CONSOLE : AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST));
+    query.Security = GetSecurity();
+    query.Viewer = _player->GetGUID();
+    query.Locale = GetSessionDbcLocale();
+    // 50 is maximum player count sent to client - can be overridden
+    // through config, but is unstable
+    query.MaxResults = sWorld->getIntConfig(CONFIG_MAX_WHO);
 
     WorldPackets::Who::WhoResponsePkt response;
 
-    WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
-    for (WhoListPlayerInfo const& target : whoList)
+    for (WhoListPlayerInfo const* target : sWhoListStorageMgr->Query(std::move(query)))
     {
-        // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
-        if (target.GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-            continue;
-
-        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
-        if (target.GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
-            continue;
-
-        // check if target is globally visible for player
-        if (_player->GetGUID() != target.GetGuid() && !target.IsVisible())
-            if (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) ||
-                target.GetSecurity() > _player->GetSession()->GetSecurity())
-                continue;
-
-        // check if target's level is in level range
-        uint8 lvl = target.GetLevel();
-        if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
-
-        // check if class matches classmask
-        if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target.GetClass())))
-            continue;
-
-        // check if race matches racemask
-        if (request.RaceFilter >= 0 && (request.RaceFilter & (1 << target.GetRace())))
-            continue;
-
-        if (!whoRequest.Request.Areas.empty())
-        {
-            if (std::find(whoRequest.Request.Areas.begin(), whoRequest.Request.Areas.end(), int32(target.GetZoneId())) ==
-                whoRequest.Request.Areas.end())
-                continue;
-        }
-
-        std::wstring const& wTargetName = target.GetWidePlayerName();
-        if (!(wPlayerName.empty() || wTargetName.find(wPlayerName) != std::wstring::npos))
-            continue;
-
-        std::wstring const& wTargetGuildName = target.GetWideGuildName();
-
-        if (!wGuildName.empty() && wTargetGuildName.find(wGuildName) == std::wstring::npos)
-            continue;
-
-        if (!wWords.empty())
-        {
-            std::string aName;
-            if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(target.GetZoneId()))
-                aName = areaEntry->AreaName[GetSessionDbcLocale()];
-
-            bool show = false;
-            for (size_t i = 0; i < wWords.size(); ++i)
-            {
-                if (!wWords[i].empty())
-                {
-                    if (wTargetName.find(wWords[i]) != std::wstring::npos ||
-                        wTargetGuildName.find(wWords[i]) != std::wstring::npos || Utf8FitTo(aName, wWords[i]))
-                    {
-                        show = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!show)
-                continue;
-        }
-
         WorldPackets::Who::WhoEntry whoEntry;
-        if (!whoEntry.PlayerData.Initialize(target.GetGuid(), nullptr))
+        if (!whoEntry.PlayerData.Initialize(target->GetGuid(), nullptr))
             continue;
 
-        if (!target.GetGuildName().empty())
-            whoEntry.GuildName = target.GetGuildName();
+        if (!target->GetGuildName().empty())
+            whoEntry.GuildName = target->GetGuildName();
 
-        whoEntry.AreaID = target.GetZoneId();
+        whoEntry.AreaID = target->GetZoneId();
 
         response.Response.Entries.push_back(whoEntry);
-
-        // 50 is maximum player count sent to client - can be overridden
-        // through config, but is unstable
-        if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            break;
     }
 
     SendPacket(response.Write());
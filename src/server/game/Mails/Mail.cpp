@@ -240,11 +240,13 @@ void MailDraft::SendMailTo(CharacterDatabaseTransaction& trans, MailReceiver con
         trans->Append(stmt);
     }
 
-    // For online receiver update in game mail status and data
     if (pReceiver)
-    {
         pReceiver->AddNewMailDeliverTime(deliver_time);
 
+    // For online receiver with a loaded (or loading) mailbox update in game mail data,
+    // otherwise the mail is read from DB when the mailbox is opened
+    if (pReceiver && pReceiver->GetMailboxState() != MAILBOX_NOT_LOADED)
+    {
         Mail* m = new Mail;
         m->messageID = mailId;
         m->mailTemplateId = GetMailTemplateId();
@@ -0,0 +1,177 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GridPreloader.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "Metric.h"
+#include "StringFormat.h"
+#include "Timer.h"
+#include "World.h"
+#include <cstdio>
+
+namespace
+{
+    // prefetched terrain nobody asked for is dropped after this time
+    uint32 const PreloadedGridExpireTime = 60 * IN_MILLISECONDS;
+
+    void ReadAhead(std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+            return;
+
+        char buffer[0x10000];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+            ;
+
+        fclose(file);
+    }
+}
+
+GridPreloader::GridPreloader() : _cancelationToken(false), _syncLoads(0), _prefetchedLoads(0), _unusedPrefetches(0)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    if (Activated())
+        Deactivate();
+}
+
+void GridPreloader::Activate(size_t numThreads)
+{
+    for (size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&GridPreloader::WorkerThread, this));
+}
+
+void GridPreloader::Deactivate()
+{
+    _cancelationToken = true;
+
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _grids.clear();
+}
+
+void GridPreloader::Prefetch(uint32 mapId, int32 gx, int32 gy, bool readVMap, bool readMMap)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        RemoveExpired();
+
+        // already queued or waiting to be picked up
+        if (!_grids.emplace(MakeKey(mapId, gx, gy), PreloadedGrid{ nullptr, getMSTime(), true }).second)
+            return;
+    }
+
+    _queue.Push({ mapId, gx, gy, readVMap, readMMap });
+}
+
+std::shared_ptr<GridMap> GridPreloader::TakeGridMap(uint32 mapId, int32 gx, int32 gy)
+{
+    std::shared_ptr<GridMap> terrain;
+    if (Activated())
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _grids.find(MakeKey(mapId, gx, gy));
+        if (itr != _grids.end() && !itr->second.Pending)
+        {
+            terrain = std::move(itr->second.Terrain);
+            _grids.erase(itr);
+        }
+    }
+
+    ++(terrain ? _prefetchedLoads : _syncLoads);
+    return terrain;
+}
+
+void GridPreloader::LogMetrics()
+{
+    FC_METRIC_VALUE("grid_terrain_loads,type=sync", _syncLoads.exchange(0));
+    FC_METRIC_VALUE("grid_terrain_loads,type=prefetched", _prefetchedLoads.exchange(0));
+    FC_METRIC_VALUE("grid_terrain_prefetch_unused", _unusedPrefetches.exchange(0));
+}
+
+void GridPreloader::WorkerThread()
+{
+    while (true)
+    {
+        Request request;
+
+        _queue.WaitAndPop(request);
+
+        if (_cancelationToken)
+            return;
+
+        Load(request);
+    }
+}
+
+void GridPreloader::Load(Request const& request)
+{
+    std::string const& dataPath = sWorld->GetDataPath();
+    std::string fileName = Firelands::StringFormat("%smaps/%03u%02u%02u.map", dataPath.c_str(), request.MapId, request.GridX, request.GridY);
+    std::shared_ptr<GridMap> terrain = std::make_shared<GridMap>();
+    if (terrain->loadData(fileName.c_str()) != GridMap::LoadResult::Ok)
+        terrain = nullptr;
+
+    if (request.ReadVMap)
+        ReadAhead(dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(request.MapId, request.GridX, request.GridY));
+
+    if (request.ReadMMap)
+        ReadAhead(Firelands::StringFormat("%smmaps/%03i%02i%02i.mmtile", dataPath.c_str(), request.MapId, request.GridX, request.GridY));
+
+    LOG_DEBUG("maps", "GridPreloader: prefetched grid [%d, %d] of map %u", request.GridX, request.GridY, request.MapId);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _grids.find(MakeKey(request.MapId, request.GridX, request.GridY));
+    if (itr == _grids.end())
+        return;
+
+    // missing terrain files are left to the synchronous path which reports them
+    if (!terrain)
+    {
+        _grids.erase(itr);
+        return;
+    }
+
+    itr->second.Terrain = std::move(terrain);
+    itr->second.LoadTime = getMSTime();
+    itr->second.Pending = false;
+}
+
+void GridPreloader::RemoveExpired()
+{
+    for (auto itr = _grids.begin(); itr != _grids.end();)
+    {
+        if (!itr->second.Pending && GetMSTimeDiffToNow(itr->second.LoadTime) > PreloadedGridExpireTime)
+        {
+            ++_unusedPrefetches;
+            itr = _grids.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GridPreloader_h__
+#define GridPreloader_h__
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class GridMap;
+
+/// Loads terrain of grids players are heading to on background threads.
+/// Terrain files are parsed into GridMap objects that Map::LoadMapImpl picks up
+/// instead of reading the file itself; vmap and mmap tiles are read ahead so the
+/// map thread finds them in the file cache. Creating the grid and loading its
+/// spawns still happens on the map thread.
+class FC_GAME_API GridPreloader
+{
+public:
+    GridPreloader();
+    ~GridPreloader();
+
+    void Activate(size_t numThreads);
+    void Deactivate();
+    bool Activated() const { return !_workerThreads.empty(); }
+
+    /// Queues terrain grid (gx, gy) of terrain map mapId, safe to call from any map thread
+    void Prefetch(uint32 mapId, int32 gx, int32 gy, bool readVMap, bool readMMap);
+
+    /// Hands over a prefetched GridMap, nullptr when the grid was not prefetched (yet)
+    std::shared_ptr<GridMap> TakeGridMap(uint32 mapId, int32 gx, int32 gy);
+
+    void LogMetrics();
+
+private:
+    struct Request
+    {
+        uint32 MapId;
+        int32 GridX;
+        int32 GridY;
+        bool ReadVMap;
+        bool ReadMMap;
+    };
+
+    struct PreloadedGrid
+    {
+        std::shared_ptr<GridMap> Terrain;
+        uint32 LoadTime;
+        bool Pending;
+    };
+
+    static uint64 MakeKey(uint32 mapId, int32 gx, int32 gy) { return (uint64(mapId) << 16) | (uint64(gx) << 8) | uint64(gy); }
+
+    void WorkerThread();
+    void Load(Request const& request);
+    void RemoveExpired();
+
+    ProducerConsumerQueue<Request> _queue;
+    std::vector<std::thread> _workerThreads;
+    std::atomic<bool> _cancelationToken;
+
+    std::mutex _lock;
+    std::unordered_map<uint64, PreloadedGrid> _grids;
+
+    std::atomic<uint32> _syncLoads;
+    std::atomic<uint32> _prefetchedLoads;
+    std::atomic<uint32> _unusedPrefetches;
+};
+
+#endif // GridPreloader_h__
@@ -26,6 +26,7 @@
 #include "GameTime.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
+#include "GridPreloader.h"
 #include "GridStates.h"
 #include "Group.h"
 #include "InstancePackets.h"
@@ -34,14 +35,17 @@
 #include "MMapFactory.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
+#include "Profiler.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "VMapFactory.h"
@@ -252,9 +256,14 @@ void Map::LoadMapImpl(Map* map, int gx, int gy)
     // map file name
     std::string fileName = Firelands::StringFormat("%smaps/%03u%02u%02u.map", sWorld->GetDataPath().c_str(), map->GetId(), gx, gy);
     LOG_DEBUG("maps", "Loading map %s", fileName.c_str());
-    // loading data
-    std::shared_ptr<GridMap> gridMap = std::make_shared<GridMap>();
-    GridMap::LoadResult gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    // loading data, unless a grid preloader thread already did it
+    GridMap::LoadResult gridMapLoadResult = GridMap::LoadResult::Ok;
+    std::shared_ptr<GridMap> gridMap = sMapMgr->GetGridPreloader()->TakeGridMap(map->GetId(), gx, gy);
+    if (!gridMap)
+    {
+        gridMap = std::make_shared<GridMap>();
+        gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    }
     if (gridMapLoadResult == GridMap::LoadResult::Ok)
         map->GridMaps[gx][gy] = std::move(gridMap);
     else
@@ -324,7 +333,7 @@ void Map::DeleteStateMachine()
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _parent)
     : _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
       m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD), m_activeNonPlayersIter(m_activeNonPlayers.end()),
-      _transportsUpdateIter(_transports.end()), i_gridExpiry(expiry), i_scriptLock(false), _respawnCheckTimer(0)
+      _transportsUpdateIter(_transports.end()), i_gridExpiry(expiry), i_scriptLock(false), _respawnCheckTimer(0), _respawnSaveTimer(0)
 {
     if (_parent)
     {
@@ -817,17 +826,22 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(uint32 t_diff)
 {
+    FC_PROFILE_ZONE_ARG("Map::Update", GetId());
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->GetSource();
-        if (player && player->IsInWorld())
+        FC_PROFILE_ZONE_ARG("Map::UpdateSessions", GetId());
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            // player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(t_diff, updater);
+            Player* player = m_mapRefIter->GetSource();
+            if (player && player->IsInWorld())
+            {
+                // player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(t_diff, updater);
+            }
         }
     }
 
@@ -840,10 +854,21 @@ void Map::Update(uint32 t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    /// write buffered respawn times
+    if (_respawnSaveTimer <= t_diff)
+    {
+        SaveBufferedRespawnTimes();
+        _respawnSaveTimer = sWorld->getIntConfig(CONFIG_RESPAWN_SAVEINTERVALMS);
+    }
+    else
+        _respawnSaveTimer -= t_diff;
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
     Firelands::ObjectUpdater updater(t_diff);
+    if (uint32 budget = sWorld->getIntConfig(CONFIG_MAP_CREATURE_UPDATE_BUDGET))
+        updater.SetCreatureUpdateBudget(Milliseconds(budget));
     // for creature
     TypeContainerVisitor<Firelands::ObjectUpdater, GridTypeMapContainer> grid_object_update(updater);
     // for pets
@@ -924,6 +949,9 @@ void Map::Update(uint32 t_diff)
         obj->Update(t_diff);
     }
 
+    if (updater.IsOverCreatureUpdateBudget())
+        FC_METRIC_VALUE(Firelands::StringFormat("map_creature_updates_deferred,map_id=%u", GetId()), updater.GetDeferredCreatureCount());
+
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -967,6 +995,8 @@ struct ResetNotifier
 
 void Map::ProcessRelocationNotifies(uint32 diff)
 {
+    FC_PROFILE_ZONE_ARG("Map::ProcessRelocationNotifies", GetId());
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType* grid = i->GetSource();
@@ -1162,12 +1192,53 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
             EnsureGridLoadedForActiveObject(new_cell, player);
 
         AddToGrid(player, new_cell);
+
+        PrefetchGridsAhead(player);
     }
 
     player->UpdatePositionData();
     player->UpdateObjectVisibility(false);
 }
 
+void Map::PrefetchGridsAhead(Player* player)
+{
+    GridPreloader* preloader = sMapMgr->GetGridPreloader();
+    if (!preloader->Activated())
+        return;
+
+    if (!player->isMoving() && player->movespline->Finalized())
+        return;
+
+    // follow the facing, which spline movement (taxi paths) keeps updated as well
+    UnitMoveType moveType = player->IsFlying() || player->IsInFlight() ? MOVE_FLIGHT : MOVE_RUN;
+    float distance = player->GetSpeed(moveType) * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) / float(IN_MILLISECONDS);
+    float x = player->GetPositionX() + std::cos(player->GetOrientation()) * distance;
+    float y = player->GetPositionY() + std::sin(player->GetOrientation()) * distance;
+    Firelands::NormalizeMapCoord(x);
+    Firelands::NormalizeMapCoord(y);
+
+    Cell cell(x, y);
+    if (getNGrid(cell.GridX(), cell.GridY()))
+        return;
+
+    // instances and child maps share the terrain of the root map, which another map may have loaded already
+    Map* terrainMap = m_parentMap->GetRootParentTerrainMap();
+    int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - cell.GridX();
+    int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - cell.GridY();
+    {
+        std::unique_lock<std::mutex> lock(terrainMap->_gridLock, std::defer_lock);
+        if (this != terrainMap)
+            lock.lock();
+
+        if (terrainMap->GridMaps[gx][gy])
+            return;
+    }
+
+    bool readVMap = VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled();
+    bool readMMap = DisableMgr::IsPathfindingEnabled(terrainMap->GetId());
+    preloader->Prefetch(terrainMap->GetId(), gx, gy, readVMap, readMMap);
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false, "Creature"));
@@ -1317,6 +1388,8 @@ void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 
 void Map::MoveAllCreaturesInMoveList()
 {
+    FC_PROFILE_ZONE_ARG("Map::MoveAllCreaturesInMoveList", GetId());
+
     _creatureToMoveLock = true;
     for (std::vector<Creature*>::iterator itr = _creaturesToMove.begin(); itr != _creaturesToMove.end(); ++itr)
     {
@@ -1680,6 +1753,8 @@ void Map::RemoveAllPlayers()
 
 void Map::UnloadAll()
 {
+    SaveBufferedRespawnTimes();
+
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
@@ -2879,6 +2954,8 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
 
 void Map::SendObjectUpdates()
 {
+    FC_PROFILE_ZONE_ARG("Map::SendObjectUpdates", GetId());
+
     UpdateDataMapType update_players;
 
     while (!_updateObjects.empty())
@@ -2977,7 +3054,7 @@ void Map::Respawn(RespawnInfo* info, CharacterDatabaseTransaction dbTrans)
     if (info->respawnTime <= GameTime::GetGameTime())
         return;
     info->respawnTime = GameTime::GetGameTime();
-    _respawnTimes.increase(info->handle);
+    _respawnTimes.Update(info);
     SaveRespawnInfoDB(*info, dbTrans);
 }
 
@@ -3031,8 +3108,7 @@ bool Map::AddRespawnInfo(RespawnInfo const& info)
     else
         ASSERT(false, "Invalid respawn info for spawn id (%u,%u) being inserted", uint32(info.type), info.spawnId);
 
-    RespawnInfo* ri = new RespawnInfo(info);
-    ri->handle = _respawnTimes.push(ri);
+    RespawnInfo* ri = _respawnTimes.Add(info);
     bySpawnIdMap.emplace(ri->spawnId, ri);
     return true;
 }
@@ -3063,9 +3139,7 @@ RespawnInfo* Map::GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawn
 
 void Map::UnloadAllRespawnInfos() // delete everything from memory
 {
-    for (RespawnInfo* info : _respawnTimes)
-        delete info;
-    _respawnTimes.clear();
+    _respawnTimes.Clear();
     _creatureRespawnTimesBySpawnId.clear();
     _gameObjectRespawnTimesBySpawnId.clear();
 }
@@ -3082,18 +3156,18 @@ void Map::DeleteRespawnInfo(RespawnInfo* info, CharacterDatabaseTransaction dbTr
     ASSERT(it != range.second, "Respawn stores inconsistent for map %u, spawnid %u (type %u)", GetId(), info->spawnId, uint32(info->type));
     spawnMap.erase(it);
 
-    // respawn heap
-    _respawnTimes.erase(info->handle);
-
     // database
     DeleteRespawnInfoFromDB(info->type, info->spawnId, dbTrans);
 
-    // then cleanup the object
-    delete info;
+    // respawn heap, also releases the object
+    _respawnTimes.Remove(info);
 }
 
 void Map::DeleteRespawnInfoFromDB(SpawnObjectType type, ObjectGuid::LowType spawnId, CharacterDatabaseTransaction dbTrans)
 {
+    if (BufferRespawnSave(type, spawnId, 0, dbTrans))
+        return;
+
     // database
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_RESPAWN);
     stmt->setUInt16(0, type);
@@ -3131,17 +3205,19 @@ void Map::DoRespawn(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 gr
 
 void Map::ProcessRespawns()
 {
+    FC_PROFILE_ZONE_ARG("Map::ProcessRespawns", GetId());
+
     time_t now = GameTime::GetGameTime();
-    while (!_respawnTimes.empty())
+    while (!_respawnTimes.Empty())
     {
-        RespawnInfo* next = _respawnTimes.top();
+        RespawnInfo* next = _respawnTimes.Top();
         if (now < next->respawnTime) // done for this tick
             break;
 
         if (uint32 poolId = sPoolMgr->IsPartOfAPool(next->type, next->spawnId)) // is this part of a pool?
         {                                                                       // if yes, respawn will be handled by (external) pooling logic, just delete the respawn time
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes.pop();
+            _respawnTimes.Pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
 
             // step 2: tell pooling logic to do its thing
@@ -3149,12 +3225,12 @@ void Map::ProcessRespawns()
 
             // step 3: get rid of the actual entry
             RemoveRespawnTime(next->type, next->spawnId, nullptr, true);
-            delete next;
+            _respawnTimes.Release(next);
         }
         else if (CheckRespawn(next)) // see if we're allowed to respawn
         {                            // ok, respawn
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes.pop();
+            _respawnTimes.Pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
 
             // step 2: do the respawn, which involves external logic
@@ -3162,19 +3238,19 @@ void Map::ProcessRespawns()
 
             // step 3: get rid of the actual entry
             RemoveRespawnTime(next->type, next->spawnId, nullptr, true);
-            delete next;
+            _respawnTimes.Release(next);
         }
         else if (!next->respawnTime)
         { // just remove this respawn entry without rescheduling
-            _respawnTimes.pop();
+            _respawnTimes.Pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
             RemoveRespawnTime(next->type, next->spawnId, nullptr, true);
-            delete next;
+            _respawnTimes.Release(next);
         }
         else
         {                                    // new respawn time, update heap position
             ASSERT(now < next->respawnTime); // infinite loop guard
-            _respawnTimes.decrease(next->handle);
+            _respawnTimes.Update(next);
             SaveRespawnInfoDB(*next);
         }
     }
@@ -4251,6 +4327,9 @@ void Map::SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uin
 
 void Map::SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans)
 {
+    if (BufferRespawnSave(info.type, info.spawnId, info.respawnTime, dbTrans))
+        return;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_RESPAWN);
     stmt->setUInt16(0, info.type);
     stmt->setUInt32(1, info.spawnId);
@@ -4260,6 +4339,57 @@ void Map::SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransactio
     CharacterDatabase.ExecuteOrAppend(dbTrans, stmt);
 }
 
+bool Map::BufferRespawnSave(SpawnObjectType type, ObjectGuid::LowType spawnId, time_t respawnTime, CharacterDatabaseTransaction const& dbTrans)
+{
+    uint64 key = uint64(type) << 32 | spawnId;
+
+    // writes that are part of a caller's transaction go out with it, a buffered value would overwrite them later
+    if (dbTrans || !sWorld->getIntConfig(CONFIG_RESPAWN_SAVEINTERVALMS))
+    {
+        _pendingRespawnSaves.erase(key);
+        return false;
+    }
+
+    _pendingRespawnSaves[key] = respawnTime;
+    return true;
+}
+
+void Map::SaveBufferedRespawnTimes()
+{
+    if (_pendingRespawnSaves.empty())
+        return;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (auto const& pair : _pendingRespawnSaves)
+    {
+        SpawnObjectType type = SpawnObjectType(pair.first >> 32);
+        ObjectGuid::LowType spawnId = ObjectGuid::LowType(pair.first & 0xFFFFFFFF);
+
+        CharacterDatabasePreparedStatement* stmt;
+        if (pair.second)
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_RESPAWN);
+            stmt->setUInt16(0, type);
+            stmt->setUInt32(1, spawnId);
+            stmt->setUInt64(2, uint64(pair.second));
+            stmt->setUInt16(3, GetId());
+            stmt->setUInt32(4, GetInstanceId());
+        }
+        else
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_RESPAWN);
+            stmt->setUInt16(0, type);
+            stmt->setUInt32(1, spawnId);
+            stmt->setUInt16(2, GetId());
+            stmt->setUInt32(3, GetInstanceId());
+        }
+        trans->Append(stmt);
+    }
+
+    _pendingRespawnSaves.clear();
+    CharacterDatabase.CommitTransaction(trans);
+}
+
 void Map::LoadRespawnTimes()
 {
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_RESPAWNS);
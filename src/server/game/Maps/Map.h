@@ -27,12 +27,12 @@
 #include "MapRefManager.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include "RespawnListContainer.h"
 #include "SharedDefines.h"
 #include "SpawnData.h"
 #include "Timer.h"
 #include "Transaction.h"
 #include "Weather.h"
-#include <boost/heap/fibonacci_heap.hpp>
 #include <bitset>
 #include <list>
 #include <memory>
@@ -302,35 +302,8 @@ struct ZoneDynamicInfo
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
 
-struct RespawnInfo; // forward declaration
-struct CompareRespawnInfo
-{
-    bool operator()(RespawnInfo const* a, RespawnInfo const* b) const;
-};
 using ZoneDynamicInfoMap = std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo>;
-using RespawnListContainer = boost::heap::fibonacci_heap<RespawnInfo*, boost::heap::compare<CompareRespawnInfo>>;
-using RespawnListHandle = RespawnListContainer::handle_type;
 using RespawnInfoMap = std::unordered_map<ObjectGuid::LowType, RespawnInfo*>;
-struct RespawnInfo
-{
-    SpawnObjectType type;
-    ObjectGuid::LowType spawnId;
-    uint32 entry;
-    time_t respawnTime;
-    uint32 gridId;
-    RespawnListHandle handle;
-};
-inline bool CompareRespawnInfo::operator()(RespawnInfo const* a, RespawnInfo const* b) const
-{
-    if (a == b)
-        return false;
-    if (a->respawnTime != b->respawnTime)
-        return (a->respawnTime > b->respawnTime);
-    if (a->spawnId != b->spawnId)
-        return a->spawnId < b->spawnId;
-    ASSERT(a->type != b->type, "Duplicate respawn entry for spawnId (%u,%u) found!", a->type, a->spawnId);
-    return a->type < b->type;
-}
 
 struct FC_GAME_API SummonCreatureExtraArgs
 {
@@ -387,6 +360,7 @@ class FC_GAME_API Map : public GridRefManager<NGridType>
         virtual void InitVisibilityDistance();
 
         void PlayerRelocation(Player*, float x, float y, float z, float orientation);
+        void PrefetchGridsAhead(Player* player);
         void CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail = true);
         void GameObjectRelocation(GameObject* go, float x, float y, float z, float orientation, bool respawnRelocationOnFail = true);
         void DynamicObjectRelocation(DynamicObject* go, float x, float y, float z, float orientation);
@@ -401,6 +375,14 @@ class FC_GAME_API Map : public GridRefManager<NGridType>
         }
         bool IsRemovalGrid(Position const& pos) const { return IsRemovalGrid(pos.GetPositionX(), pos.GetPositionY()); }
 
+        // grids stay active while players or active objects are near them
+        bool IsGridActive(float x, float y) const
+        {
+            GridCoord p = Firelands::ComputeGridCoord(x, y);
+            NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+            return grid && grid->GetGridState() == GRID_STATE_ACTIVE;
+        }
+
         bool IsGridLoaded(uint32 gridId) const { return IsGridLoaded(GridCoord(gridId % MAX_NUMBER_OF_GRIDS, gridId / MAX_NUMBER_OF_GRIDS)); }
         bool IsGridLoaded(float x, float y) const { return IsGridLoaded(Firelands::ComputeGridCoord(x, y)); }
         bool IsGridLoaded(Position const& pos) const { return IsGridLoaded(pos.GetPositionX(), pos.GetPositionY()); }
@@ -654,7 +636,8 @@ class FC_GAME_API Map : public GridRefManager<NGridType>
         void SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans = nullptr, bool startup = false);
         void SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans = nullptr);
         void LoadRespawnTimes();
-        void DeleteRespawnTimes() { UnloadAllRespawnInfos(); DeleteRespawnTimesInDB(GetId(), GetInstanceId()); }
+        void DeleteRespawnTimes() { UnloadAllRespawnInfos(); _pendingRespawnSaves.clear(); DeleteRespawnTimesInDB(GetId(), GetInstanceId()); }
+        void SaveBufferedRespawnTimes();
         static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId);
 
         void LoadCorpseData();
@@ -851,6 +834,7 @@ class FC_GAME_API Map : public GridRefManager<NGridType>
         void Respawn(RespawnInfo* info, CharacterDatabaseTransaction dbTrans = nullptr);
         void DeleteRespawnInfo(RespawnInfo* info, CharacterDatabaseTransaction dbTrans = nullptr);
         void DeleteRespawnInfoFromDB(SpawnObjectType type, ObjectGuid::LowType spawnId, CharacterDatabaseTransaction dbTrans = nullptr);
+        bool BufferRespawnSave(SpawnObjectType type, ObjectGuid::LowType spawnId, time_t respawnTime, CharacterDatabaseTransaction const& dbTrans);
 
     public:
         void GetRespawnInfo(std::vector<RespawnInfo const*>& respawnData, SpawnObjectTypeMask types) const;
@@ -953,6 +937,9 @@ class FC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+        // respawn times not yet written to the database, 0 means the row is to be deleted
+        std::unordered_map<uint64 /*type << 32 | spawnId*/, time_t> _pendingRespawnSaves;
+        uint32 _respawnSaveTimer;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
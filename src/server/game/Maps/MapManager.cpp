@@ -21,6 +21,7 @@
 #include "DBCStores.h"
 #include "Log.h"
 #include "ObjectAccessor.h"
+#include "Profiler.h"
 #include "Transport.h"
 #include "GridDefines.h"
 #include "MapInstanced.h"
@@ -53,6 +54,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 preloadThreads = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS))
+        _gridPreloader.Activate(preloadThreads);
 }
 
 void MapManager::InitializeParentMapData(std::unordered_map<uint32, std::vector<uint32>> const& mapData)
@@ -242,6 +246,8 @@ Map::EnterState MapManager::PlayerCannotEnter(uint32 mapid, Player* player, bool
 
 void MapManager::Update(uint32 diff)
 {
+    FC_PROFILE_ZONE("MapManager::Update");
+
     i_timer.Update(diff);
     if (!i_timer.Passed())
         return;
@@ -302,6 +308,9 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (_gridPreloader.Activated())
+        _gridPreloader.Deactivate();
+
     Map::DeleteStateMachine();
 }
 
@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "MapInstanced.h"
 #include "GridStates.h"
+#include "GridPreloader.h"
 #include "MapUpdater.h"
 #include <boost/dynamic_bitset.hpp>
 
@@ -129,6 +130,7 @@ class FC_GAME_API MapManager
         void FreeInstanceId(uint32 instanceId);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        GridPreloader* GetGridPreloader() { return &_gridPreloader; }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
@@ -167,6 +169,7 @@ class FC_GAME_API MapManager
         InstanceIds _freeInstanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        GridPreloader _gridPreloader;
 
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
@@ -17,6 +17,7 @@
 
 #include "MapUpdater.h"
 #include "Map.h"
+#include "Profiler.h"
 
 #include <mutex>
 
@@ -100,6 +101,8 @@ void MapUpdater::update_finished()
 
 void MapUpdater::WorkerThread()
 {
+    sProfiler->SetThreadName("MapUpdater");
+
     while (1)
     {
         MapUpdateRequest* request = nullptr;
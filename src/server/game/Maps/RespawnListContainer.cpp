@@ -0,0 +1,149 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RespawnListContainer.h"
+#include "Errors.h"
+
+RespawnInfo* RespawnListContainer::Add(RespawnInfo const& info)
+{
+    if (_free.empty())
+    {
+        _chunks.emplace_back(new RespawnInfo[ChunkSize]);
+        RespawnInfo* chunk = _chunks.back().get();
+        _free.reserve(_free.size() + ChunkSize);
+        for (uint32 i = ChunkSize; i > 0; --i)
+            _free.push_back(&chunk[i - 1]);
+    }
+
+    RespawnInfo* entry = _free.back();
+    _free.pop_back();
+    *entry = info;
+
+    _heap.push_back({ entry->respawnTime, entry });
+    entry->heapIndex = uint32(_heap.size() - 1);
+    SiftUp(entry->heapIndex);
+    return entry;
+}
+
+void RespawnListContainer::Remove(RespawnInfo* info)
+{
+    Detach(info->heapIndex);
+    Release(info);
+}
+
+void RespawnListContainer::Pop()
+{
+    ASSERT(!_heap.empty());
+    Detach(0);
+}
+
+void RespawnListContainer::Release(RespawnInfo* info)
+{
+    ASSERT(info->heapIndex == InvalidIndex, "Respawn entry (%u,%u) released while still scheduled", uint32(info->type), info->spawnId);
+    _free.push_back(info);
+}
+
+void RespawnListContainer::Update(RespawnInfo* info)
+{
+    uint32 index = info->heapIndex;
+    ASSERT(index < _heap.size() && _heap[index].Info == info);
+    _heap[index].RespawnTime = info->respawnTime;
+    SiftUp(index);
+    SiftDown(info->heapIndex);
+}
+
+void RespawnListContainer::Clear()
+{
+    _heap.clear();
+    _free.clear();
+    _free.reserve(_chunks.size() * ChunkSize);
+    for (std::unique_ptr<RespawnInfo[]> const& chunk : _chunks)
+        for (uint32 i = ChunkSize; i > 0; --i)
+            _free.push_back(&chunk[i - 1]);
+}
+
+bool RespawnListContainer::Before(Node const& a, Node const& b)
+{
+    if (a.RespawnTime != b.RespawnTime)
+        return a.RespawnTime < b.RespawnTime;
+    if (a.Info->spawnId != b.Info->spawnId)
+        return a.Info->spawnId < b.Info->spawnId;
+    ASSERT(a.Info == b.Info || a.Info->type != b.Info->type, "Duplicate respawn entry for spawnId (%u,%u) found!", uint32(a.Info->type), a.Info->spawnId);
+    return a.Info->type < b.Info->type;
+}
+
+void RespawnListContainer::Place(uint32 index, Node const& node)
+{
+    _heap[index] = node;
+    node.Info->heapIndex = index;
+}
+
+void RespawnListContainer::SiftUp(uint32 index)
+{
+    Node node = _heap[index];
+    while (index > 0)
+    {
+        uint32 parent = (index - 1) / 2;
+        if (!Before(node, _heap[parent]))
+            break;
+
+        Place(index, _heap[parent]);
+        index = parent;
+    }
+    Place(index, node);
+}
+
+void RespawnListContainer::SiftDown(uint32 index)
+{
+    uint32 const size = uint32(_heap.size());
+    Node node = _heap[index];
+    while (true)
+    {
+        uint32 child = index * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && Before(_heap[child + 1], _heap[child]))
+            ++child;
+
+        if (!Before(_heap[child], node))
+            break;
+
+        Place(index, _heap[child]);
+        index = child;
+    }
+    Place(index, node);
+}
+
+void RespawnListContainer::Detach(uint32 index)
+{
+    ASSERT(index < _heap.size());
+    RespawnInfo* info = _heap[index].Info;
+    uint32 last = uint32(_heap.size() - 1);
+    if (index != last)
+    {
+        RespawnInfo* moved = _heap[last].Info;
+        Place(index, _heap[last]);
+        _heap.pop_back();
+        SiftUp(index);
+        SiftDown(moved->heapIndex);
+    }
+    else
+        _heap.pop_back();
+
+    info->heapIndex = InvalidIndex;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RespawnListContainer_h__
+#define RespawnListContainer_h__
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include "SpawnData.h"
+#include <ctime>
+#include <memory>
+#include <vector>
+
+struct RespawnInfo
+{
+    SpawnObjectType type;
+    ObjectGuid::LowType spawnId;
+    uint32 entry;
+    time_t respawnTime;
+    uint32 gridId;
+    uint32 heapIndex;
+};
+
+/// Respawn schedule of a map, ordered by respawn time.
+/// Entries are allocated from chunks owned by the container and kept in an indexed
+/// binary heap whose nodes carry the respawn time, so ordering rarely has to touch the entries themselves.
+class FC_GAME_API RespawnListContainer
+{
+public:
+    RespawnListContainer() = default;
+    RespawnListContainer(RespawnListContainer const&) = delete;
+    RespawnListContainer& operator=(RespawnListContainer const&) = delete;
+
+    /// Copies info into a pooled entry and schedules it
+    RespawnInfo* Add(RespawnInfo const& info);
+    /// Unschedules the entry and returns it to the pool
+    void Remove(RespawnInfo* info);
+    /// Unschedules the earliest entry, it stays valid until passed to Release
+    void Pop();
+    /// Returns an entry detached by Pop to the pool
+    void Release(RespawnInfo* info);
+    /// Restores ordering after info->respawnTime was changed
+    void Update(RespawnInfo* info);
+    void Clear();
+
+    RespawnInfo* Top() const { return _heap.front().Info; }
+    bool Empty() const { return _heap.empty(); }
+    size_t Size() const { return _heap.size(); }
+
+private:
+    static uint32 const ChunkSize = 256;
+    static uint32 const InvalidIndex = 0xFFFFFFFF;
+
+    struct Node
+    {
+        time_t RespawnTime;
+        RespawnInfo* Info;
+    };
+
+    static bool Before(Node const& a, Node const& b);
+    void Place(uint32 index, Node const& node);
+    void SiftUp(uint32 index);
+    void SiftDown(uint32 index);
+    void Detach(uint32 index);
+
+    std::vector<Node> _heap;
+    std::vector<std::unique_ptr<RespawnInfo[]>> _chunks;
+    std::vector<RespawnInfo*> _free;
+};
+
+#endif // RespawnListContainer_h__
@@ -134,7 +134,8 @@ namespace Movement
             packet.SplineData.Move.VehicleSeat = unit->GetTransSeat();
         }
 
-        unit->SendMessageToSet(packet.Write(), true);
+        packet.Write();
+        unit->SendSharedMessageToSet(std::make_shared<WorldPacket const>(packet.Move()), true);
 
         return move_spline.Duration();
     }
@@ -189,7 +190,8 @@ namespace Movement
             packet.SplineData.Move.TransportGUID = unit->GetTransGUID();
             packet.SplineData.Move.VehicleSeat = unit->GetTransSeat();
         }
-        unit->SendMessageToSet(packet.Write(), true);
+        packet.Write();
+        unit->SendSharedMessageToSet(std::make_shared<WorldPacket const>(packet.Move()), true);
     }
 
     MoveSplineInit::MoveSplineInit(Unit* m) : unit(m)
@@ -25,6 +25,9 @@ bool PhaseShift::AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Conditio
     if (areaConditions)
         insertResult.first->AreaConditions = areaConditions;
 
+    if (insertResult.second)
+        UpdatePhaseMasks();
+
     return insertResult.second;
 }
 
@@ -35,7 +38,11 @@ PhaseShift::EraseResult<PhaseShift::PhaseContainer> PhaseShift::RemovePhase(uint
     {
         ModifyPhasesReferences(itr, -1);
         if (!itr->References)
-            return { Phases.erase(itr), true };
+        {
+            itr = Phases.erase(itr);
+            UpdatePhaseMasks();
+            return { itr, true };
+        }
         return { itr, false };
     }
     return { Phases.end(), false };
@@ -91,6 +98,7 @@ void PhaseShift::ClearPhases()
 {
     Flags &= EnumFlag<PhaseShiftFlags>(PhaseShiftFlags::AlwaysVisible) | PhaseShiftFlags::Inverse;
     Phases.clear();
+    PhaseMasks = { };
     NonCosmeticReferences = 0;
     CosmeticReferences = 0;
     DefaultReferences = 0;
@@ -106,14 +114,21 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
     if (Flags.HasFlag(PhaseShiftFlags::Inverse) && other.Flags.HasFlag(PhaseShiftFlags::Inverse))
         return true;
 
-    PhaseFlags excludePhasesWithFlag = PhaseFlags::None;
-    if (Flags.HasFlag(PhaseShiftFlags::NoCosmetic) && other.Flags.HasFlag(PhaseShiftFlags::NoCosmetic))
-        excludePhasesWithFlag = PhaseFlags::Cosmetic;
+    bool excludeCosmetic = Flags.HasFlag(PhaseShiftFlags::NoCosmetic) && other.Flags.HasFlag(PhaseShiftFlags::NoCosmetic);
+    PhaseFlags excludePhasesWithFlag = excludeCosmetic ? PhaseFlags::Cosmetic : PhaseFlags::None;
 
     if (!Flags.HasFlag(PhaseShiftFlags::Inverse) && !other.Flags.HasFlag(PhaseShiftFlags::Inverse))
     {
         ObjectGuid ownerGuid = PersonalGuid;
         ObjectGuid otherPersonalGuid = other.PersonalGuid;
+        uint64 sharedPhases = PhaseMasks[PhaseMaskIndex(excludeCosmetic, ownerGuid != otherPersonalGuid)] & other.PhaseMasks[PhaseMaskIndex(false, false)];
+        if (!sharedPhases)
+            return false;
+
+        // both in a single phase, the mask check already filtered its flags
+        if (Phases.size() == 1 && other.Phases.size() == 1)
+            return Phases.begin()->Id == other.Phases.begin()->Id;
+
         return Firelands::Containers::Intersects(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(),
             [&ownerGuid, &otherPersonalGuid, excludePhasesWithFlag](PhaseRef const& myPhase, PhaseRef const& /*otherPhase*/)
         {
@@ -121,11 +136,15 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
         });
     }
 
-    auto checkInversePhaseShift = [excludePhasesWithFlag](PhaseShift const& phaseShift, PhaseShift const& excludedPhaseShift)
+    auto checkInversePhaseShift = [excludeCosmetic, excludePhasesWithFlag](PhaseShift const& phaseShift, PhaseShift const& excludedPhaseShift)
     {
         if (phaseShift.Flags.HasFlag(PhaseShiftFlags::Unphased) && excludedPhaseShift.Flags.HasFlag(PhaseShiftFlags::InverseUnphased))
             return false;
 
+        std::size_t maskIndex = PhaseMaskIndex(excludeCosmetic, false);
+        if (!(phaseShift.PhaseMasks[maskIndex] & excludedPhaseShift.PhaseMasks[maskIndex]))
+            return true;
+
         for (auto itr = phaseShift.Phases.begin(); itr != phaseShift.Phases.end(); ++itr)
         {
             if (itr->Flags.HasFlag(excludePhasesWithFlag))
@@ -167,6 +186,21 @@ void PhaseShift::ModifyPhasesReferences(PhaseContainer::iterator itr, int32 refe
     }
 }
 
+void PhaseShift::UpdatePhaseMasks()
+{
+    PhaseMasks = { };
+    for (PhaseRef const& phase : Phases)
+    {
+        bool cosmetic = phase.Flags.HasFlag(PhaseFlags::Cosmetic);
+        bool personal = phase.Flags.HasFlag(PhaseFlags::Personal);
+        uint64 bit = GetPhaseMaskBit(phase.Id);
+        for (bool excludeCosmetic : { false, true })
+            for (bool excludePersonal : { false, true })
+                if ((!cosmetic || !excludeCosmetic) && (!personal || !excludePersonal))
+                    PhaseMasks[PhaseMaskIndex(excludeCosmetic, excludePersonal)] |= bit;
+    }
+}
+
 void PhaseShift::UpdateUnphasedFlag()
 {
     EnumFlag<PhaseShiftFlags> unphasedFlag = !Flags.HasFlag(PhaseShiftFlags::Inverse) ? PhaseShiftFlags::Unphased : PhaseShiftFlags::InverseUnphased;
@@ -22,6 +22,7 @@
 #include "EnumFlag.h"
 #include "ObjectGuid.h"
 #include <boost/container/flat_set.hpp>
+#include <array>
 #include <map>
 
 class PhasingHandler;
@@ -85,7 +86,7 @@ public:
     typedef std::map<uint32, VisibleMapIdRef> VisibleMapIdContainer;
     typedef std::map<uint32, UiMapPhaseIdRef> UiMapPhaseIdContainer;
 
-    PhaseShift() : Flags(PhaseShiftFlags::Unphased), NonCosmeticReferences(0), CosmeticReferences(0), DefaultReferences(0), IsDbPhaseShift(false) { }
+    PhaseShift() : Flags(PhaseShiftFlags::Unphased), PhaseMasks(), NonCosmeticReferences(0), CosmeticReferences(0), DefaultReferences(0), IsDbPhaseShift(false) { }
 
     bool AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Condition*> const* areaConditions, int32 references = 1);
     EraseResult<PhaseContainer> RemovePhase(uint32 phaseId);
@@ -116,7 +117,15 @@ protected:
     VisibleMapIdContainer VisibleMapIds;
     UiMapPhaseIdContainer UiMapPhaseIds;
 
+    // Phase ids hashed into 64 bits, one mask per combination of excluded PhaseFlags (see PhaseMaskIndex).
+    // Disjoint masks prove two phase shifts share no phase, overlapping ones are confirmed on Phases.
+    std::array<uint64, 4> PhaseMasks;
+
+    static uint64 GetPhaseMaskBit(uint32 phaseId) { return UI64LIT(1) << (phaseId & 63); }
+    static std::size_t PhaseMaskIndex(bool excludeCosmetic, bool excludePersonal) { return (excludeCosmetic ? 1 : 0) | (excludePersonal ? 2 : 0); }
+
     void ModifyPhasesReferences(PhaseContainer::iterator itr, int32 references);
+    void UpdatePhaseMasks();
     void UpdateUnphasedFlag();
     int32 NonCosmeticReferences;
     int32 CosmeticReferences;
@@ -294,6 +294,9 @@ void PhasingHandler::OnConditionChange(WorldObject* object)
             ++itr;
     }
 
+    phaseShift.UpdatePhaseMasks();
+    suppressedPhaseShift.UpdatePhaseMasks();
+
     for (auto itr = phaseShift.VisibleMapIds.begin(); itr != phaseShift.VisibleMapIds.end();)
     {
         if (!sConditionMgr->IsObjectMeetingNotGroupedConditions(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, itr->first, srcInfo))
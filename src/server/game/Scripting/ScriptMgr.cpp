@@ -110,6 +110,24 @@ template <> struct is_script_database_bound<QuestScript> : std::true_type
 {
 };
 
+// Trait which holds the number of hooks tracked by ScriptHookTracker
+// for this script type, 0 if it is not tracked.
+template <typename> struct script_hook_count : std::integral_constant<uint8, 0>
+{
+};
+
+template <> struct script_hook_count<WorldScript> : std::integral_constant<uint8, WORLDHOOK_END>
+{
+};
+
+template <> struct script_hook_count<UnitScript> : std::integral_constant<uint8, UNITHOOK_END>
+{
+};
+
+template <> struct script_hook_count<PlayerScript> : std::integral_constant<uint8, PLAYERHOOK_END>
+{
+};
+
 enum Spells
 {
     SPELL_HOTSWAP_VISUAL_SPELL_EFFECT = 40162 // 59084
@@ -813,10 +831,58 @@ template <typename Base> class ScriptRegistrySwapHooks<QuestScript, Base> : publ
     bool swapped;
 };
 
+// Per hook listener lists of a tracked script type. Every script starts out as a listener of all hooks
+// and is dropped from a list once it reported falling through to the empty default implementation.
+template <typename ScriptType, uint8 HookCount> class ScriptHookListenerRegistry
+{
+  public:
+    std::vector<ScriptType*> const& GetHookListeners(uint8 hook) const { return _hookListeners[hook]; }
+
+    // Must not run while hooks are dispatched, called from the world thread while no map is updated.
+    void PruneHookListeners()
+    {
+        uint32 const generation = ScriptHookTracker::GetUnusedHookGeneration();
+        if (generation == _prunedGeneration)
+            return;
+
+        _prunedGeneration = generation;
+        for (uint8 hook = 0; hook < HookCount; ++hook)
+        {
+            std::vector<ScriptType*>& listeners = _hookListeners[hook];
+            listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                [hook](ScriptType* script) { return script->IsHookUnused(hook); }),
+                listeners.end());
+        }
+    }
+
+  protected:
+    template <typename ScriptStoreType> void RebuildHookListeners(ScriptStoreType const& scripts)
+    {
+        for (uint8 hook = 0; hook < HookCount; ++hook)
+        {
+            _hookListeners[hook].clear();
+            for (auto const& entry : scripts)
+                if (!entry.second->IsHookUnused(hook))
+                    _hookListeners[hook].push_back(entry.second.get());
+        }
+    }
+
+  private:
+    std::array<std::vector<ScriptType*>, HookCount> _hookListeners;
+    uint32 _prunedGeneration = 0;
+};
+
+template <typename ScriptType> class ScriptHookListenerRegistry<ScriptType, 0>
+{
+  protected:
+    template <typename ScriptStoreType> void RebuildHookListeners(ScriptStoreType const& /*scripts*/) {}
+};
+
 // Database unbound script registry
 template <typename ScriptType>
 class SpecializedScriptRegistry<ScriptType, false> : public ScriptRegistryInterface,
-                                                     public ScriptRegistrySwapHooks<ScriptType, ScriptRegistry<ScriptType>>
+                                                     public ScriptRegistrySwapHooks<ScriptType, ScriptRegistry<ScriptType>>,
+                                                     public ScriptHookListenerRegistry<ScriptType, script_hook_count<ScriptType>::value>
 {
     template <typename, typename> friend class ScriptRegistrySwapHooks;
 
@@ -831,6 +897,7 @@ class SpecializedScriptRegistry<ScriptType, false> : public ScriptRegistryInterf
         this->BeforeReleaseContext(context);
 
         _scripts.erase(context);
+        this->RebuildHookListeners(_scripts);
     }
 
     void SwapContext(bool initialize) final override { this->BeforeSwapContext(initialize); }
@@ -846,6 +913,7 @@ class SpecializedScriptRegistry<ScriptType, false> : public ScriptRegistryInterf
         this->BeforeUnload();
 
         _scripts.clear();
+        this->RebuildHookListeners(_scripts);
     }
 
     // Adds a non database bound script
@@ -868,6 +936,7 @@ class SpecializedScriptRegistry<ScriptType, false> : public ScriptRegistryInterf
 
         // We're dealing with a code-only script, just add it.
         _scripts.insert(std::make_pair(sScriptMgr->GetCurrentScriptContext(), std::move(script_ptr)));
+        this->RebuildHookListeners(_scripts);
     }
 
     ScriptStoreType& GetScripts() { return _scripts; }
@@ -896,6 +965,11 @@ class SpecializedScriptRegistry<ScriptType, false> : public ScriptRegistryInterf
     FOR_SCRIPTS(T, itr, end)                                                                                                     \
     itr->second
 
+// Loops over the scripts implementing a hook of a tracked script type only.
+#define FOREACH_SCRIPT_HOOK(T, H)                                                                                                \
+    for (T* listener : ScriptRegistry<T>::Instance()->GetHookListeners(H))                                                      \
+    listener
+
 // Utility macros for finding specific scripts.
 #define GET_SCRIPT(T, I, V)                                                                                                      \
     T* V = ScriptRegistry<T>::Instance()->GetScriptById(I);                                                                      \
@@ -917,6 +991,8 @@ ScriptObject::ScriptObject(char const* name) : _name(name) { sScriptMgr->Increas
 
 ScriptObject::~ScriptObject() { sScriptMgr->DecreaseScriptCount(); }
 
+std::atomic<uint32> ScriptHookTracker::_unusedHookGeneration(0);
+
 ScriptMgr::ScriptMgr() : _scriptCount(0), _script_loader_callback(nullptr), _modules_loader_callback(nullptr) {}
 
 ScriptMgr::~ScriptMgr() {}
@@ -1200,20 +1276,28 @@ void ScriptMgr::OnPacketSend(WorldSession* session, WorldPacket const& packet)
     FOREACH_SCRIPT(ServerScript)->OnPacketSend(session, copy);
 }
 
-void ScriptMgr::OnOpenStateChange(bool open) { FOREACH_SCRIPT(WorldScript)->OnOpenStateChange(open); }
+void ScriptMgr::OnOpenStateChange(bool open) { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_OPEN_STATE_CHANGE)->OnOpenStateChange(open); }
 
-void ScriptMgr::OnConfigLoad(bool reload) { FOREACH_SCRIPT(WorldScript)->OnConfigLoad(reload); }
+void ScriptMgr::OnConfigLoad(bool reload) { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_CONFIG_LOAD)->OnConfigLoad(reload); }
 
-void ScriptMgr::OnMotdChange(std::string& newMotd) { FOREACH_SCRIPT(WorldScript)->OnMotdChange(newMotd); }
+void ScriptMgr::OnMotdChange(std::string& newMotd) { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_MOTD_CHANGE)->OnMotdChange(newMotd); }
 
 void ScriptMgr::OnShutdownInitiate(ShutdownExitCode code, ShutdownMask mask)
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownInitiate(code, mask);
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_SHUTDOWN_INITIATE)->OnShutdownInitiate(code, mask);
 }
 
-void ScriptMgr::OnShutdownCancel() { FOREACH_SCRIPT(WorldScript)->OnShutdownCancel(); }
+void ScriptMgr::OnShutdownCancel() { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_SHUTDOWN_CANCEL)->OnShutdownCancel(); }
 
-void ScriptMgr::OnWorldUpdate(uint32 diff) { FOREACH_SCRIPT(WorldScript)->OnUpdate(diff); }
+void ScriptMgr::OnWorldUpdate(uint32 diff)
+{
+    // Maps are not updated at this point, so no hook is being dispatched while the listeners shrink
+    ScriptRegistry<WorldScript>::Instance()->PruneHookListeners();
+    ScriptRegistry<UnitScript>::Instance()->PruneHookListeners();
+    ScriptRegistry<PlayerScript>::Instance()->PruneHookListeners();
+
+    FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_UPDATE)->OnUpdate(diff);
+}
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
 {
@@ -1344,7 +1428,7 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
     ASSERT(map);
     ASSERT(player);
 
-    FOREACH_SCRIPT(PlayerScript)->OnMapChanged(player);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_MAP_CHANGED)->OnMapChanged(player);
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
     itr->second->OnPlayerEnter(map, player);
@@ -1739,9 +1823,9 @@ void ScriptMgr::OnRelocate(Transport* transport, uint32 mapId, float x, float y,
     tmpscript->OnRelocate(transport, mapId, x, y, z);
 }
 
-void ScriptMgr::OnStartup() { FOREACH_SCRIPT(WorldScript)->OnStartup(); }
+void ScriptMgr::OnStartup() { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_STARTUP)->OnStartup(); }
 
-void ScriptMgr::OnShutdown() { FOREACH_SCRIPT(WorldScript)->OnShutdown(); }
+void ScriptMgr::OnShutdown() { FOREACH_SCRIPT_HOOK(WorldScript, WORLDHOOK_ON_SHUTDOWN)->OnShutdown(); }
 
 bool ScriptMgr::OnCriteriaCheck(uint32 scriptId, Player* source, Unit* target)
 {
@@ -1753,132 +1837,132 @@ bool ScriptMgr::OnCriteriaCheck(uint32 scriptId, Player* source, Unit* target)
 }
 
 // Player
-void ScriptMgr::OnPVPKill(Player* killer, Player* killed) { FOREACH_SCRIPT(PlayerScript)->OnPVPKill(killer, killed); }
+void ScriptMgr::OnPVPKill(Player* killer, Player* killed) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_PVP_KILL)->OnPVPKill(killer, killed); }
 
-void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed) { FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed); }
+void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CREATURE_KILL)->OnCreatureKill(killer, killed); }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerKilledByCreature(killer, killed);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE)->OnPlayerKilledByCreature(killer, killed);
 }
 
 void ScriptMgr::OnPlayerLevelChanged(Player* player, uint8 oldLevel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLevelChanged(player, oldLevel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_LEVEL_CHANGED)->OnLevelChanged(player, oldLevel);
 }
 
 void ScriptMgr::OnPlayerFreeTalentPointsChanged(Player* player, uint32 points)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFreeTalentPointsChanged(player, points);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED)->OnFreeTalentPointsChanged(player, points);
 }
 
 void ScriptMgr::OnPlayerTalentsReset(Player* player, bool noCost)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTalentsReset(player, noCost);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_TALENTS_RESET)->OnTalentsReset(player, noCost);
 }
 
 void ScriptMgr::OnPlayerMoneyChanged(Player* player, int64& amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_MONEY_CHANGED)->OnMoneyChanged(player, amount);
 }
 
-void ScriptMgr::OnPlayerMoneyLimit(Player* player, int64 amount) { FOREACH_SCRIPT(PlayerScript)->OnMoneyLimit(player, amount); }
+void ScriptMgr::OnPlayerMoneyLimit(Player* player, int64 amount) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_MONEY_LIMIT)->OnMoneyLimit(player, amount); }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_GIVE_XP)->OnGiveXP(player, amount, victim);
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, int32& standing, bool incremental)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_REPUTATION_CHANGE)->OnReputationChange(player, factionID, standing, incremental);
 }
 
 void ScriptMgr::OnPlayerDuelRequest(Player* target, Player* challenger)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelRequest(target, challenger);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_DUEL_REQUEST)->OnDuelRequest(target, challenger);
 }
 
 void ScriptMgr::OnPlayerDuelStart(Player* player1, Player* player2)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelStart(player1, player2);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_DUEL_START)->OnDuelStart(player1, player2);
 }
 
 void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType type)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelEnd(winner, loser, type);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_DUEL_END)->OnDuelEnd(winner, loser, type);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CHAT)->OnChat(player, type, lang, msg);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CHAT_WHISPER)->OnChat(player, type, lang, msg, receiver);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CHAT_GROUP)->OnChat(player, type, lang, msg, group);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CHAT_GUILD)->OnChat(player, type, lang, msg, guild);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Channel* channel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, channel);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CHAT_CHANNEL)->OnChat(player, type, lang, msg, channel);
 }
 
-void ScriptMgr::OnPlayerClearEmote(Player* player) { FOREACH_SCRIPT(PlayerScript)->OnClearEmote(player); }
+void ScriptMgr::OnPlayerClearEmote(Player* player) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CLEAR_EMOTE)->OnClearEmote(player); }
 
 void ScriptMgr::OnPlayerTextEmote(Player* player, uint32 textEmote, uint32 emoteNum, ObjectGuid guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTextEmote(player, textEmote, emoteNum, guid);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_TEXT_EMOTE)->OnTextEmote(player, textEmote, emoteNum, guid);
 }
 
 void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_SPELL_CAST)->OnSpellCast(player, spell, skipCheck);
 }
 
-void ScriptMgr::OnPlayerLogin(Player* player, bool firstLogin) { FOREACH_SCRIPT(PlayerScript)->OnLogin(player, firstLogin); }
+void ScriptMgr::OnPlayerLogin(Player* player, bool firstLogin) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_LOGIN)->OnLogin(player, firstLogin); }
 
-void ScriptMgr::OnPlayerLogout(Player* player) { FOREACH_SCRIPT(PlayerScript)->OnLogout(player); }
+void ScriptMgr::OnPlayerLogout(Player* player) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_LOGOUT)->OnLogout(player); }
 
-void ScriptMgr::OnPlayerCreate(Player* player) { FOREACH_SCRIPT(PlayerScript)->OnCreate(player); }
+void ScriptMgr::OnPlayerCreate(Player* player) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_CREATE)->OnCreate(player); }
 
-void ScriptMgr::OnPlayerDelete(ObjectGuid guid, uint32 accountId) { FOREACH_SCRIPT(PlayerScript)->OnDelete(guid, accountId); }
+void ScriptMgr::OnPlayerDelete(ObjectGuid guid, uint32 accountId) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_DELETE)->OnDelete(guid, accountId); }
 
 void ScriptMgr::OnPlayerFailedDelete(ObjectGuid guid, uint32 accountId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFailedDelete(guid, accountId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_FAILED_DELETE)->OnFailedDelete(guid, accountId);
 }
 
-void ScriptMgr::OnPlayerSave(Player* player) { FOREACH_SCRIPT(PlayerScript)->OnSave(player); }
+void ScriptMgr::OnPlayerSave(Player* player) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_SAVE)->OnSave(player); }
 
 void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, uint32 mapid, bool permanent, uint8 extendState)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBindToInstance(player, difficulty, mapid, permanent, extendState);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_BIND_TO_INSTANCE)->OnBindToInstance(player, difficulty, mapid, permanent, extendState);
 }
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_UPDATE_ZONE)->OnUpdateZone(player, newZone, newArea);
 }
 
 void ScriptMgr::OnQuestStatusChange(Player* player, uint32 questId)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnQuestStatusChange(player, questId);
+    FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_QUEST_STATUS_CHANGE)->OnQuestStatusChange(player, questId);
 }
 
-void ScriptMgr::OnPlayerRepop(Player* player) { FOREACH_SCRIPT(PlayerScript)->OnPlayerRepop(player); }
+void ScriptMgr::OnPlayerRepop(Player* player) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_PLAYER_REPOP)->OnPlayerRepop(player); }
 
-void ScriptMgr::OnPlayerUpdate(Player* player, uint32 diff) { FOREACH_SCRIPT(PlayerScript)->OnUpdate(player, diff); }
+void ScriptMgr::OnPlayerUpdate(Player* player, uint32 diff) { FOREACH_SCRIPT_HOOK(PlayerScript, PLAYERHOOK_ON_UPDATE)->OnUpdate(player, diff); }
 
 // Account
 void ScriptMgr::OnAccountLogin(uint32 accountId) { FOREACH_SCRIPT(AccountScript)->OnAccountLogin(accountId); }
@@ -1982,26 +2066,26 @@ void ScriptMgr::OnGroupDisband(Group* group)
 }
 
 // Unit
-void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain) { FOREACH_SCRIPT(UnitScript)->OnHeal(healer, reciever, gain); }
+void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain) { FOREACH_SCRIPT_HOOK(UnitScript, UNITHOOK_ON_HEAL)->OnHeal(healer, reciever, gain); }
 
 void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->OnDamage(attacker, victim, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, UNITHOOK_ON_DAMAGE)->OnDamage(attacker, victim, damage);
 }
 
 void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
 }
 
 void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyMeleeDamage(target, attacker, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, UNITHOOK_MODIFY_MELEE_DAMAGE)->ModifyMeleeDamage(target, attacker, damage);
 }
 
 void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifySpellDamageTaken(target, attacker, damage);
+    FOREACH_SCRIPT_HOOK(UnitScript, UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN)->ModifySpellDamageTaken(target, attacker, damage);
 }
 
 void ScriptMgr::OnQuestStatusChange(Player* player, Quest const* quest, QuestStatus oldStatus, QuestStatus newStatus)
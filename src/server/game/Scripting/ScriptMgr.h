@@ -18,6 +18,7 @@
 #ifndef SC_SCRIPTMGR_H
 #define SC_SCRIPTMGR_H
 
+#include <atomic>
 #include <vector>
 
 #include "Common.h"
@@ -178,6 +179,99 @@ class FC_GAME_API ScriptObject
     const std::string _name;
 };
 
+/// Remembers which hooks of a script fell through to their empty default implementation. Registries of
+/// tracked script types keep a listener list per hook and drop such scripts from it, so dispatching a hook
+/// no script implements costs a single branch.
+/// The default implementation cannot tell whether it was dispatched to or called from an override, so an
+/// override of a tracked hook must never call the base class version (e.g. PlayerScript::OnLogin): doing
+/// so reports the hook as unused and the script stops receiving it after the next prune.
+class FC_GAME_API ScriptHookTracker
+{
+  public:
+    bool IsHookUnused(uint8 hook) const { return (_unusedHooks.load(std::memory_order_relaxed) & (UI64LIT(1) << hook)) != 0; }
+
+    /// Changes whenever a script reports a hook it does not implement
+    static uint32 GetUnusedHookGeneration() { return _unusedHookGeneration.load(std::memory_order_relaxed); }
+
+  protected:
+    ScriptHookTracker() : _unusedHooks(0) {}
+
+    // Called from the default implementation of every tracked hook, may happen on any map thread
+    void MarkHookUnused(uint8 hook) const
+    {
+        uint64 mask = UI64LIT(1) << hook;
+        if (!(_unusedHooks.fetch_or(mask, std::memory_order_relaxed) & mask))
+            _unusedHookGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  private:
+    mutable std::atomic<uint64> _unusedHooks;
+    static std::atomic<uint32> _unusedHookGeneration;
+};
+
+enum WorldHook : uint8
+{
+    WORLDHOOK_ON_OPEN_STATE_CHANGE,
+    WORLDHOOK_ON_CONFIG_LOAD,
+    WORLDHOOK_ON_MOTD_CHANGE,
+    WORLDHOOK_ON_SHUTDOWN_INITIATE,
+    WORLDHOOK_ON_SHUTDOWN_CANCEL,
+    WORLDHOOK_ON_UPDATE,
+    WORLDHOOK_ON_STARTUP,
+    WORLDHOOK_ON_SHUTDOWN,
+    WORLDHOOK_END
+};
+
+enum UnitHook : uint8
+{
+    UNITHOOK_ON_HEAL,
+    UNITHOOK_ON_DAMAGE,
+    UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK,
+    UNITHOOK_MODIFY_MELEE_DAMAGE,
+    UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN,
+    UNITHOOK_END
+};
+
+enum PlayerHook : uint8
+{
+    PLAYERHOOK_ON_PVP_KILL,
+    PLAYERHOOK_ON_CREATURE_KILL,
+    PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE,
+    PLAYERHOOK_ON_LEVEL_CHANGED,
+    PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED,
+    PLAYERHOOK_ON_TALENTS_RESET,
+    PLAYERHOOK_ON_MONEY_CHANGED,
+    PLAYERHOOK_ON_MONEY_LIMIT,
+    PLAYERHOOK_ON_GIVE_XP,
+    PLAYERHOOK_ON_REPUTATION_CHANGE,
+    PLAYERHOOK_ON_DUEL_REQUEST,
+    PLAYERHOOK_ON_DUEL_START,
+    PLAYERHOOK_ON_DUEL_END,
+    PLAYERHOOK_ON_CHAT,
+    PLAYERHOOK_ON_CHAT_WHISPER,
+    PLAYERHOOK_ON_CHAT_GROUP,
+    PLAYERHOOK_ON_CHAT_GUILD,
+    PLAYERHOOK_ON_CHAT_CHANNEL,
+    PLAYERHOOK_ON_CLEAR_EMOTE,
+    PLAYERHOOK_ON_TEXT_EMOTE,
+    PLAYERHOOK_ON_SPELL_CAST,
+    PLAYERHOOK_ON_LOGIN,
+    PLAYERHOOK_ON_LOGOUT,
+    PLAYERHOOK_ON_CREATE,
+    PLAYERHOOK_ON_DELETE,
+    PLAYERHOOK_ON_FAILED_DELETE,
+    PLAYERHOOK_ON_SAVE,
+    PLAYERHOOK_ON_BIND_TO_INSTANCE,
+    PLAYERHOOK_ON_UPDATE_ZONE,
+    PLAYERHOOK_ON_MAP_CHANGED,
+    PLAYERHOOK_ON_QUEST_STATUS_CHANGE,
+    PLAYERHOOK_ON_PLAYER_REPOP,
+    PLAYERHOOK_ON_UPDATE,
+    PLAYERHOOK_END
+};
+
+static_assert(PLAYERHOOK_END <= 64, "ScriptHookTracker keeps the hooks of a script in a 64 bit mask");
+
 template <class TObject> class UpdatableScript
 {
   protected:
@@ -231,35 +325,37 @@ class FC_GAME_API ServerScript : public ScriptObject
     virtual void OnPacketReceive(WorldSession* /*session*/, WorldPacket& /*packet*/) {}
 };
 
-class FC_GAME_API WorldScript : public ScriptObject
+// WARNING: hooks of this script type are tracked by ScriptHookTracker. Overrides must not call the base
+// implementation (WorldScript::OnUpdate(...)), it marks the hook unused and the override is never called again.
+class FC_GAME_API WorldScript : public ScriptObject, public ScriptHookTracker
 {
   protected:
     WorldScript(char const* name);
 
   public:
     // Called when the open/closed state of the world changes.
-    virtual void OnOpenStateChange(bool /*open*/) {}
+    virtual void OnOpenStateChange(bool /*open*/) { MarkHookUnused(WORLDHOOK_ON_OPEN_STATE_CHANGE); }
 
     // Called after the world configuration is (re)loaded.
-    virtual void OnConfigLoad(bool /*reload*/) {}
+    virtual void OnConfigLoad(bool /*reload*/) { MarkHookUnused(WORLDHOOK_ON_CONFIG_LOAD); }
 
     // Called before the message of the day is changed.
-    virtual void OnMotdChange(std::string& /*newMotd*/) {}
+    virtual void OnMotdChange(std::string& /*newMotd*/) { MarkHookUnused(WORLDHOOK_ON_MOTD_CHANGE); }
 
     // Called when a world shutdown is initiated.
-    virtual void OnShutdownInitiate(ShutdownExitCode /*code*/, ShutdownMask /*mask*/) {}
+    virtual void OnShutdownInitiate(ShutdownExitCode /*code*/, ShutdownMask /*mask*/) { MarkHookUnused(WORLDHOOK_ON_SHUTDOWN_INITIATE); }
 
     // Called when a world shutdown is cancelled.
-    virtual void OnShutdownCancel() {}
+    virtual void OnShutdownCancel() { MarkHookUnused(WORLDHOOK_ON_SHUTDOWN_CANCEL); }
 
     // Called on every world tick (don't execute too heavy code here).
-    virtual void OnUpdate(uint32 /*diff*/) {}
+    virtual void OnUpdate(uint32 /*diff*/) { MarkHookUnused(WORLDHOOK_ON_UPDATE); }
 
     // Called when the world is started.
-    virtual void OnStartup() {}
+    virtual void OnStartup() { MarkHookUnused(WORLDHOOK_ON_STARTUP); }
 
     // Called when the world is actually shut down.
-    virtual void OnShutdown() {}
+    virtual void OnShutdown() { MarkHookUnused(WORLDHOOK_ON_SHUTDOWN); }
 };
 
 class FC_GAME_API FormulaScript : public ScriptObject
@@ -368,26 +464,28 @@ class FC_GAME_API ItemScript : public ScriptObject
     }
 };
 
-class FC_GAME_API UnitScript : public ScriptObject
+// WARNING: hooks of this script type are tracked by ScriptHookTracker. Overrides must not call the base
+// implementation (UnitScript::OnDamage(...)), it marks the hook unused and the override is never called again.
+class FC_GAME_API UnitScript : public ScriptObject, public ScriptHookTracker
 {
   protected:
     UnitScript(char const* name);
 
   public:
     // Called when a unit deals healing to another unit
-    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) {}
+    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) { MarkHookUnused(UNITHOOK_ON_HEAL); }
 
     // Called when a unit deals damage to another unit
-    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) {}
+    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) { MarkHookUnused(UNITHOOK_ON_DAMAGE); }
 
     // Called when DoT's Tick Damage is being Dealt
-    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) {}
+    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { MarkHookUnused(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK); }
 
     // Called when Melee Damage is being Dealt
-    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) {}
+    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) { MarkHookUnused(UNITHOOK_MODIFY_MELEE_DAMAGE); }
 
     // Called when Spell Damage is being Dealt
-    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) {}
+    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/) { MarkHookUnused(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN); }
 };
 
 class FC_GAME_API CreatureScript : public ScriptObject
@@ -595,108 +693,111 @@ class FC_GAME_API AchievementCriteriaScript : public ScriptObject
     virtual bool OnCheck(Player* source, Unit* target) = 0;
 };
 
-class FC_GAME_API PlayerScript : public ScriptObject
+// WARNING: hooks of this script type are tracked by ScriptHookTracker. Overrides must not call the base
+// implementation (PlayerScript::OnLogin(...)), it marks the hook unused and the override is never called again.
+class FC_GAME_API PlayerScript : public ScriptObject, public ScriptHookTracker
 {
   protected:
     PlayerScript(char const* name);
 
   public:
     // Called when a player kills another player
-    virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) {}
+    virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { MarkHookUnused(PLAYERHOOK_ON_PVP_KILL); }
 
     // Called when a player kills a creature
-    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) {}
+    virtual void OnCreatureKill(Player* /*killer*/, Creature* /*killed*/) { MarkHookUnused(PLAYERHOOK_ON_CREATURE_KILL); }
 
     // Called when a player is killed by a creature
-    virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) {}
+    virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) { MarkHookUnused(PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE); }
 
     // Called when a player's level changes (after the level is applied)
-    virtual void OnLevelChanged(Player* /*player*/, uint8 /*oldLevel*/) {}
+    virtual void OnLevelChanged(Player* /*player*/, uint8 /*oldLevel*/) { MarkHookUnused(PLAYERHOOK_ON_LEVEL_CHANGED); }
 
     // Called when a player's free talent points change (right before the change is applied)
-    virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) {}
+    virtual void OnFreeTalentPointsChanged(Player* /*player*/, uint32 /*points*/) { MarkHookUnused(PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED); }
 
     // Called when a player's talent points are reset (right before the reset is done)
-    virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) {}
+    virtual void OnTalentsReset(Player* /*player*/, bool /*noCost*/) { MarkHookUnused(PLAYERHOOK_ON_TALENTS_RESET); }
 
     // Called when a player's money is modified (before the modification is done)
-    virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) {}
+    virtual void OnMoneyChanged(Player* /*player*/, int64& /*amount*/) { MarkHookUnused(PLAYERHOOK_ON_MONEY_CHANGED); }
 
     // Called when a player's money is at limit (amount = money tried to add)
-    virtual void OnMoneyLimit(Player* /*player*/, int64 /*amount*/) {}
+    virtual void OnMoneyLimit(Player* /*player*/, int64 /*amount*/) { MarkHookUnused(PLAYERHOOK_ON_MONEY_LIMIT); }
 
     // Called when a player gains XP (before anything is given)
-    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) {}
+    virtual void OnGiveXP(Player* /*player*/, uint32& /*amount*/, Unit* /*victim*/) { MarkHookUnused(PLAYERHOOK_ON_GIVE_XP); }
 
     // Called when a player's reputation changes (before it is actually changed)
-    virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, int32& /*standing*/, bool /*incremental*/) {}
+    virtual void OnReputationChange(Player* /*player*/, uint32 /*factionId*/, int32& /*standing*/, bool /*incremental*/) { MarkHookUnused(PLAYERHOOK_ON_REPUTATION_CHANGE); }
 
     // Called when a duel is requested
-    virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) {}
+    virtual void OnDuelRequest(Player* /*target*/, Player* /*challenger*/) { MarkHookUnused(PLAYERHOOK_ON_DUEL_REQUEST); }
 
     // Called when a duel starts (after 3s countdown)
-    virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) {}
+    virtual void OnDuelStart(Player* /*player1*/, Player* /*player2*/) { MarkHookUnused(PLAYERHOOK_ON_DUEL_START); }
 
     // Called when a duel ends
-    virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) {}
+    virtual void OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelCompleteType /*type*/) { MarkHookUnused(PLAYERHOOK_ON_DUEL_END); }
 
     // The following methods are called when a player sends a chat message.
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) {}
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/) { MarkHookUnused(PLAYERHOOK_ON_CHAT); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) {}
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/) { MarkHookUnused(PLAYERHOOK_ON_CHAT_WHISPER); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) {}
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/) { MarkHookUnused(PLAYERHOOK_ON_CHAT_GROUP); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) {}
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/) { MarkHookUnused(PLAYERHOOK_ON_CHAT_GUILD); }
 
-    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) {}
+    virtual void OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/) { MarkHookUnused(PLAYERHOOK_ON_CHAT_CHANNEL); }
 
     // Both of the below are called on emote opcodes.
-    virtual void OnClearEmote(Player* /*player*/) {}
+    virtual void OnClearEmote(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_CLEAR_EMOTE); }
 
-    virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, ObjectGuid /*guid*/) {}
+    virtual void OnTextEmote(Player* /*player*/, uint32 /*textEmote*/, uint32 /*emoteNum*/, ObjectGuid /*guid*/) { MarkHookUnused(PLAYERHOOK_ON_TEXT_EMOTE); }
 
     // Called in Spell::Cast.
-    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) {}
+    virtual void OnSpellCast(Player* /*player*/, Spell* /*spell*/, bool /*skipCheck*/) { MarkHookUnused(PLAYERHOOK_ON_SPELL_CAST); }
 
     // Called when a player logs in.
-    virtual void OnLogin(Player* /*player*/, bool /*firstLogin*/) {}
+    virtual void OnLogin(Player* /*player*/, bool /*firstLogin*/) { MarkHookUnused(PLAYERHOOK_ON_LOGIN); }
 
     // Called when a player logs out.
-    virtual void OnLogout(Player* /*player*/) {}
+    virtual void OnLogout(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_LOGOUT); }
 
     // Called when a player is created.
-    virtual void OnCreate(Player* /*player*/) {}
+    virtual void OnCreate(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_CREATE); }
 
     // Called when a player is deleted.
-    virtual void OnDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) {}
+    virtual void OnDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { MarkHookUnused(PLAYERHOOK_ON_DELETE); }
 
     // Called when a player delete failed
-    virtual void OnFailedDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) {}
+    virtual void OnFailedDelete(ObjectGuid /*guid*/, uint32 /*accountId*/) { MarkHookUnused(PLAYERHOOK_ON_FAILED_DELETE); }
 
     // Called when a player is about to be saved.
-    virtual void OnSave(Player* /*player*/) {}
+    virtual void OnSave(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_SAVE); }
 
     // Called when a player is bound to an instance
     virtual void OnBindToInstance(
         Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/, uint8 /*extendState*/)
     {
+        MarkHookUnused(PLAYERHOOK_ON_BIND_TO_INSTANCE);
     }
 
     // Called when a player switches to a new zone
-    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) {}
+    virtual void OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/) { MarkHookUnused(PLAYERHOOK_ON_UPDATE_ZONE); }
 
     // Called when a player changes to a new map (after moving to new map)
-    virtual void OnMapChanged(Player* /*player*/) {}
+    virtual void OnMapChanged(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_MAP_CHANGED); }
 
     // Called after a player's quest status has been changed
-    virtual void OnQuestStatusChange(Player* /*player*/, uint32 /*questId*/) {}
+    virtual void OnQuestStatusChange(Player* /*player*/, uint32 /*questId*/) { MarkHookUnused(PLAYERHOOK_ON_QUEST_STATUS_CHANGE); }
 
     // Called when a player presses release when he died
-    virtual void OnPlayerRepop(Player* /*player*/) {}
+    virtual void OnPlayerRepop(Player* /*player*/) { MarkHookUnused(PLAYERHOOK_ON_PLAYER_REPOP); }
 
     // Called at each player update
-    virtual void OnUpdate(Player* /*player*/, uint32 /*diff*/) {}
+    virtual void OnUpdate(Player* /*player*/, uint32 /*diff*/) { MarkHookUnused(PLAYERHOOK_ON_UPDATE); }
 };
 
 class FC_GAME_API AccountScript : public ScriptObject
@@ -17,6 +17,7 @@
 
 #include "Opcodes.h"
 #include "Log.h"
+#include "Metric.h"
 #include "WorldSession.h"
 #include "Packets/AllPackets.h"
 #include <iomanip>
@@ -1744,6 +1745,24 @@ void OpcodeTable::Initialize()
 #undef DEFINE_SERVER_OPCODE_HANDLER
 }
 
+void OpcodeTable::LogMetrics() const
+{
+    for (uint32 i = 0; i < NUM_OPCODE_HANDLERS; ++i)
+    {
+        ClientOpcodeHandler* handler = _internalTableClient[i];
+        if (!handler || !handler->Latency.GetCount())
+            continue;
+
+        LatencyHistogram::Snapshot latency = handler->Latency.TakeSnapshot();
+        std::string tags = std::string(",opcode=") + handler->Name;
+        FC_METRIC_VALUE("opcode_handler_calls" + tags, latency.Count);
+        FC_METRIC_VALUE("opcode_handler_time" + tags, latency.TotalMicroseconds);
+        FC_METRIC_VALUE("opcode_handler_latency_p50" + tags, latency.GetPercentile(50));
+        FC_METRIC_VALUE("opcode_handler_latency_p99" + tags, latency.GetPercentile(99));
+        FC_METRIC_VALUE("opcode_handler_latency_max" + tags, latency.MaxMicroseconds);
+    }
+}
+
 template<typename T>
 inline std::string GetOpcodeNameForLoggingImpl(T id)
 {
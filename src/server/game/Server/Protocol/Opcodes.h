@@ -26,6 +26,7 @@
 #include <string>
 
 #include "Define.h"
+#include "LatencyHistogram.h"
 
 enum OpcodeClient : uint16 {
   CMSG_ACCEPT_LEVEL_GRANT = 0x0205,
@@ -1463,6 +1464,9 @@ class ClientOpcodeHandler : public OpcodeHandler {
   virtual void Call(WorldSession* session, WorldPacket& packet) const = 0;
 
   PacketProcessing ProcessingPlace;
+
+  // handler time of every call, written from world and map threads alike
+  mutable LatencyHistogram Latency;
 };
 
 class ServerOpcodeHandler : public OpcodeHandler {
@@ -1490,6 +1494,10 @@ class OpcodeTable {
     return _internalTableServer[index];
   }
 
+  /// Sends call counts and handler latency percentiles of the opcodes
+  /// received since the previous call to the metric system
+  void LogMetrics() const;
+
  private:
   template <typename Handler, Handler HandlerFunction>
   void ValidateAndSetClientOpcode(OpcodeClient opcode, char const* name,
@@ -46,6 +46,7 @@
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
 #include "Player.h"
+#include "Profiler.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "Realm.h"
@@ -176,7 +177,7 @@ WorldSession::~WorldSession() {
 
   ///- empty incoming packet queue
   WorldPacket *packet = nullptr;
-  while (_recvQueue.next(packet)) delete packet;
+  while (_recvQueue.Dequeue(packet)) delete packet;
 
   LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;",
                          GetAccountId());  // One-time query
@@ -212,14 +213,28 @@ ObjectGuid::LowType WorldSession::GetGUIDLow() const {
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const *packet,
                               bool forced /*= false*/) {
+  if (!CanSendPacket(packet, forced)) return;
+
+  m_Socket->SendPacket(*packet);
+}
+
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const &packet,
+                              bool forced /*= false*/) {
+  if (!CanSendPacket(packet.get(), forced)) return;
+
+  m_Socket->SendPacket(packet);
+}
+
+/// Validates an outgoing packet and runs the send hooks
+bool WorldSession::CanSendPacket(WorldPacket const *packet, bool forced) {
   if (packet->GetOpcode() == NULL_OPCODE) {
     LOG_ERROR("network.opcode", "Prevented sending of NULL_OPCODE to %s",
               GetPlayerInfo().c_str());
-    return;
+    return false;
   } else if (packet->GetOpcode() == UNKNOWN_OPCODE) {
     LOG_ERROR("network.opcode", "Prevented sending of UNKNOWN_OPCODE to %s",
               GetPlayerInfo().c_str());
-    return;
+    return false;
   }
 
   ServerOpcodeHandler const *handler =
@@ -229,7 +244,7 @@ void WorldSession::SendPacket(WorldPacket const *packet,
     LOG_ERROR("network.opcode",
               "Prevented sending of opcode %u with non existing handler to %s",
               packet->GetOpcode(), GetPlayerInfo().c_str());
-    return;
+    return false;
   }
 
   if (!m_Socket) {
@@ -239,7 +254,7 @@ void WorldSession::SendPacket(WorldPacket const *packet,
         GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode()))
             .c_str(),
         GetPlayerInfo().c_str());
-    return;
+    return false;
   }
 
   if (!forced) {
@@ -251,7 +266,7 @@ void WorldSession::SendPacket(WorldPacket const *packet,
                     static_cast<OpcodeServer>(packet->GetOpcode()))
                     .c_str(),
                 GetPlayerInfo().c_str());
-      return;
+      return false;
     }
   }
 
@@ -302,12 +317,12 @@ void WorldSession::SendPacket(WorldPacket const *packet,
       "network.opcode", "S->C: %s %s", GetPlayerInfo().c_str(),
       GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode()))
           .c_str());
-  m_Socket->SendPacket(*packet);
+  return true;
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket *new_packet) {
-  _recvQueue.add(new_packet);
+  _recvQueue.Enqueue(new_packet);
 }
 
 /// Logging helper for unexpected opcodes
@@ -321,6 +336,24 @@ void WorldSession::LogUnexpectedOpcode(WorldPacket *packet, char const *status,
       status, reason, GetPlayerInfo().c_str());
 }
 
+bool WorldSession::CallOpcodeHandler(ClientOpcodeHandler const *opHandle,
+                                     WorldPacket &packet, time_t currentTime) {
+  // typed handlers move the packet contents away
+  uint16 opcode = packet.GetOpcode();
+
+  sScriptMgr->OnPacketReceive(this, packet);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  opHandle->Call(this, packet);
+  uint64 elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  opHandle->Latency.Record(elapsed);
+  return AntiDOS.EvaluateHandlerTime(opcode, elapsed, currentTime);
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnprocessedTail(WorldPacket const *packet) {
   if (!sLog->ShouldLog("network.opcode", LOG_LEVEL_TRACE) ||
@@ -359,9 +392,10 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
 
   constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-  while (m_Socket && _recvQueue.next(packet, updater)) {
+  while (m_Socket && _recvQueue.Dequeue(packet, updater)) {
     ClientOpcodeHandler const *opHandle =
         opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
+    FC_PROFILE_ZONE_ARG(opHandle->Name, packet->GetOpcode());
     try {
       switch (opHandle->Status) {
         case STATUS_LOGGEDIN:
@@ -385,8 +419,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
             }
           } else if (_player->IsInWorld() &&
                      AntiDOS.EvaluateOpcode(*packet, currentTime)) {
-            sScriptMgr->OnPacketReceive(this, *packet);
-            opHandle->Call(this, *packet);
+            if (!CallOpcodeHandler(opHandle, *packet, currentTime))
+              processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;
           } else
             processedPackets =
                 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;  // break out
@@ -406,8 +440,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
                 "the player has not logged in yet and not recently logout");
           else if (AntiDOS.EvaluateOpcode(*packet, currentTime)) {
             // not expected _player or must checked in packet hanlder
-            sScriptMgr->OnPacketReceive(this, *packet);
-            opHandle->Call(this, *packet);
+            if (!CallOpcodeHandler(opHandle, *packet, currentTime))
+              processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;
           } else
             processedPackets =
                 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;  // break out
@@ -423,8 +457,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
             LogUnexpectedOpcode(packet, "STATUS_TRANSFER",
                                 "the player is still in world");
           else if (AntiDOS.EvaluateOpcode(*packet, currentTime)) {
-            sScriptMgr->OnPacketReceive(this, *packet);
-            opHandle->Call(this, *packet);
+            if (!CallOpcodeHandler(opHandle, *packet, currentTime))
+              processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;
           } else
             processedPackets =
                 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;  // break out
@@ -448,8 +482,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
             m_playerRecentlyLogout = false;
 
           if (AntiDOS.EvaluateOpcode(*packet, currentTime)) {
-            sScriptMgr->OnPacketReceive(this, *packet);
-            opHandle->Call(this, *packet);
+            if (!CallOpcodeHandler(opHandle, *packet, currentTime))
+              processedPackets = MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;
           } else
             processedPackets =
                 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE;  // break out
@@ -503,7 +537,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter &updater) {
 
   FC_METRIC_VALUE("processed_packets", processedPackets);
 
-  _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+  _recvQueue.Requeue(requeuePackets.begin(), requeuePackets.end());
 
   if (m_Socket && m_Socket->IsOpen() && _warden) _warden->Update();
 
@@ -1137,6 +1171,7 @@ void WorldSession::SetPlayer(Player *player) {
 }
 
 void WorldSession::ProcessQueryCallbacks() {
+  FC_PROFILE_ZONE("WorldSession::ProcessQueryCallbacks");
   _queryProcessor.ProcessReadyCallbacks();
   _transactionCallbacks.ProcessReadyCallbacks();
   _queryHolderProcessor.ProcessReadyCallbacks();
@@ -1272,6 +1307,27 @@ void WorldSession::InvalidateRBACData() {
 
 bool WorldSession::DosProtection::EvaluateOpcode(WorldPacket &p,
                                                  time_t time) const {
+  // Session wide rate, counting opcodes without a limit of their own
+  if (uint32 maxSessionPackets =
+          sWorld->getIntConfig(CONFIG_PACKET_SPOOF_MAX_SESSION_PACKETS)) {
+    if (_sessionPacketCounter.lastReceiveTime != time) {
+      _sessionPacketCounter.lastReceiveTime = time;
+      _sessionPacketCounter.amountCounter = 0;
+    }
+
+    if (++_sessionPacketCounter.amountCounter == maxSessionPackets + 1) {
+      LOG_WARN("network",
+               "AntiDOS: Account %u, IP: %s, Ping: %u, Character: %s, "
+               "flooding session (last opc: %s (0x%X), count: %u)",
+               Session->GetAccountId(), Session->GetRemoteAddress().c_str(),
+               Session->GetLatency(), Session->GetPlayerName().c_str(),
+               opcodeTable[static_cast<OpcodeClient>(p.GetOpcode())]->Name,
+               p.GetOpcode(), _sessionPacketCounter.amountCounter);
+
+      if (!ApplyPolicy("session")) return false;
+    }
+  }
+
   uint32 maxPacketCounterAllowed = GetMaxPacketCounterAllowed(p.GetOpcode());
 
   // Return true if there no limit for the opcode
@@ -1294,11 +1350,73 @@ bool WorldSession::DosProtection::EvaluateOpcode(WorldPacket &p,
            opcodeTable[static_cast<OpcodeClient>(p.GetOpcode())]->Name,
            p.GetOpcode(), packetCounter.amountCounter);
 
+  return ApplyPolicy("opcode");
+}
+
+bool WorldSession::DosProtection::EvaluateHandlerTime(uint16 opcode,
+                                                      uint64 microseconds,
+                                                      time_t time) const {
+  uint32 maxHandlerTime =
+      sWorld->getIntConfig(CONFIG_PACKET_SPOOF_MAX_HANDLER_TIME);
+  if (!maxHandlerTime || !IsHandlerTimeCharged(opcode)) return true;
+
+  if (_handlerTimeSecond != time) {
+    _handlerTimeSecond = time;
+    _handlerTime = 0;
+  }
+
+  _handlerTime += microseconds;
+  if (_handlerTime <= uint64(maxHandlerTime) * IN_MILLISECONDS) return true;
+
+  LOG_WARN("network",
+           "AntiDOS: Account %u, IP: %s, Ping: %u, Character: %s, flooding "
+           "handler time (last opc: %s (0x%X), time: " UI64FMTD " us)",
+           Session->GetAccountId(), Session->GetRemoteAddress().c_str(),
+           Session->GetLatency(), Session->GetPlayerName().c_str(),
+           opcodeTable[static_cast<OpcodeClient>(opcode)]->Name, opcode,
+           _handlerTime);
+
+  // punish once per second, not for every following packet
+  _handlerTime = 0;
+  return ApplyPolicy("handler_time");
+}
+
+bool WorldSession::DosProtection::IsHandlerTimeCharged(uint16 opcode) const {
+  switch (opcode) {
+    // loads the destination map
+    case MSG_MOVE_WORLDPORT_ACK:
+      return false;
+    // may run chat commands, which are allowed to block for GMs
+    case CMSG_MESSAGECHAT_AFK:
+    case CMSG_MESSAGECHAT_BATTLEGROUND:
+    case CMSG_MESSAGECHAT_CHANNEL:
+    case CMSG_MESSAGECHAT_DND:
+    case CMSG_MESSAGECHAT_EMOTE:
+    case CMSG_MESSAGECHAT_GUILD:
+    case CMSG_MESSAGECHAT_OFFICER:
+    case CMSG_MESSAGECHAT_PARTY:
+    case CMSG_MESSAGECHAT_RAID:
+    case CMSG_MESSAGECHAT_RAID_WARNING:
+    case CMSG_MESSAGECHAT_SAY:
+    case CMSG_MESSAGECHAT_WHISPER:
+    case CMSG_MESSAGECHAT_YELL:
+      return Session->GetSecurity() == SEC_PLAYER;
+    default:
+      return true;
+  }
+}
+
+bool WorldSession::DosProtection::ApplyPolicy(char const *reason) const {
+  // the account is in the log lines, a metric tag per account would create a
+  // series for every account
+  FC_METRIC_VALUE(std::string("packet_flood,type=") + reason, 1);
+
   switch (_policy) {
     case POLICY_LOG:
       return true;
     case POLICY_KICK: {
-      LOG_WARN("network", "AntiDOS: Player kicked!");
+      LOG_WARN("network", "AntiDOS: Account %u kicked for %s flooding.",
+               Session->GetAccountId(), reason);
       Session->KickPlayer();
       return false;
     }
@@ -1319,8 +1437,9 @@ bool WorldSession::DosProtection::EvaluateOpcode(WorldPacket &p,
       sWorld->BanAccount(bm, nameOrIp, duration,
                          "DOS (Packet Flooding/Spoofing", "Server: AutoDOS");
       LOG_WARN("network",
-               "AntiDOS: Player automatically banned for %u seconds.",
-               duration);
+               "AntiDOS: Account %u automatically banned for %u seconds for "
+               "%s flooding.",
+               Session->GetAccountId(), duration, reason);
       Session->KickPlayer();
       return false;
     }
@@ -1598,7 +1717,10 @@ uint32 WorldSession::DosProtection::GetMaxPacketCounterAllowed(
 
 WorldSession::DosProtection::DosProtection(WorldSession *s)
     : Session(s),
-      _policy((Policy)sWorld->getIntConfig(CONFIG_PACKET_SPOOF_POLICY)) {}
+      _policy((Policy)sWorld->getIntConfig(CONFIG_PACKET_SPOOF_POLICY)),
+      _sessionPacketCounter(),
+      _handlerTimeSecond(0),
+      _handlerTime(0) {}
 
 void WorldSession::ResetTimeSync() {
   _timeSyncNextCounter = 0;
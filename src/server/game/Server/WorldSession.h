@@ -30,12 +30,13 @@
 #include "AsyncCallbackProcessor.h"
 #include "Common.h"
 #include "DatabaseEnvFwd.h"
-#include "LockedQueue.h"
 #include "ObjectGuid.h"
 #include "Packet.h"
+#include "PeekableMPSCQueue.h"
 #include "SharedDefines.h"
 
 class BigNumber;
+class ClientOpcodeHandler;
 class Creature;
 class GameClient;
 class GameObject;
@@ -430,6 +431,10 @@ class FC_GAME_API WorldSession {
   void SendAddonsInfo();
   bool IsAddonRegistered(const std::string& prefix) const;
   void SendPacket(WorldPacket const* packet, bool forced = false);
+  /// Sends a packet whose payload is shared with other sessions instead of
+  /// copied for each of them
+  void SendPacket(std::shared_ptr<WorldPacket const> const& packet,
+                  bool forced = false);
   void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) {
     m_Socket = sock;
   }
@@ -503,6 +508,11 @@ class FC_GAME_API WorldSession {
   void SendListInventory(ObjectGuid guid);
   void SendShowBank(ObjectGuid guid);
   bool CanOpenMailBox(ObjectGuid guid);
+  void SendMailList(ObjectGuid mailbox);
+  // loads the mails of a player whose mailbox is MAILBOX_NOT_LOADED and
+  // calls onLoaded afterwards, unless the player logged out meanwhile
+  void LoadMailbox(std::function<void()> onLoaded);
+  void SendQueryNextMailTime();
   void SendShowMailBox(ObjectGuid guid);
   void SendTabardVendorActivate(ObjectGuid guid);
   void SendSpiritResurrect();
@@ -593,6 +603,9 @@ class FC_GAME_API WorldSession {
   }
   char const* GetFirelandsString(uint32 entry) const;
 
+  // packets received but not handled yet
+  std::size_t GetRecvQueueSize() const { return _recvQueue.Size(); }
+
   uint32 GetLatency() const { return m_latency; }
   void SetLatency(uint32 latency) { m_latency = latency; }
 
@@ -635,6 +648,8 @@ class FC_GAME_API WorldSession {
   void HandleLoadScreenOpcode(
       WorldPackets::Character::LoadingScreenNotify& packet);
   void HandlePlayerLogin(LoginQueryHolder const& holder);
+  // login latency percentiles since the previous call
+  static void LogLoginMetrics();
   void HandleCharFactionOrRaceChange(WorldPacket& recvData);
   void HandleCharFactionOrRaceChangeCallback(
       std::shared_ptr<CharacterFactionChangeInfo> factionChangeInfo,
@@ -1310,6 +1325,7 @@ class FC_GAME_API WorldSession {
 
  private:
   void ProcessQueryCallbacks();
+  bool CanSendPacket(WorldPacket const* packet, bool forced);
 
   QueryCallbackProcessor _queryProcessor;
   AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
@@ -1324,6 +1340,10 @@ class FC_GAME_API WorldSession {
    public:
     DosProtection(WorldSession* s);
     bool EvaluateOpcode(WorldPacket& p, time_t time) const;
+    // charges handler time to the session, a client keeping the world busy
+    // with otherwise permitted packets is flooding as well
+    bool EvaluateHandlerTime(uint16 opcode, uint64 microseconds,
+                             time_t time) const;
 
    protected:
     enum Policy {
@@ -1337,11 +1357,19 @@ class FC_GAME_API WorldSession {
     WorldSession* Session;
 
    private:
+    bool ApplyPolicy(char const* reason) const;
+    // handlers expected to block, like map changes and GM commands, are not
+    // charged
+    bool IsHandlerTimeCharged(uint16 opcode) const;
+
     Policy _policy;
     typedef std::unordered_map<uint16, PacketCounter> PacketThrottlingMap;
     // mark this member as "mutable" so it can be modified even in const
     // functions
     mutable PacketThrottlingMap _PacketThrottlingMap;
+    mutable PacketCounter _sessionPacketCounter;
+    mutable time_t _handlerTimeSecond;
+    mutable uint64 _handlerTime;  // in microseconds
 
     DosProtection(DosProtection const& right) = delete;
     DosProtection& operator=(DosProtection const& right) = delete;
@@ -1357,6 +1385,11 @@ class FC_GAME_API WorldSession {
   void LogUnexpectedOpcode(WorldPacket* packet, char const* status,
                            const char* reason);
 
+  // runs the handler and accounts its time, returns false when the session
+  // was punished for flooding
+  bool CallOpcodeHandler(ClientOpcodeHandler const* opHandle,
+                         WorldPacket& packet, time_t currentTime);
+
   // EnumData helpers
   bool IsLegitCharacterForAccount(ObjectGuid lowGUID) {
     return _legitCharacters.find(lowGUID) != _legitCharacters.end();
@@ -1420,7 +1453,7 @@ class FC_GAME_API WorldSession {
   bool _filterAddonMessages;
   uint32 recruiterId;
   bool isRecruiter;
-  LockedQueue<WorldPacket*> _recvQueue;
+  PeekableMPSCQueue<WorldPacket> _recvQueue;
   rbac::RBACData* _RBACData;
   uint32 expireTime;
   bool forceExit;
@@ -0,0 +1,107 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "WorldSessionUpdater.h"
+#include "WorldSession.h"
+
+class WorldSessionUpdateRequest
+{
+    private:
+        std::vector<WorldSession*> _sessions;
+        WorldSessionUpdater& _updater;
+
+    public:
+        WorldSessionUpdateRequest(std::vector<WorldSession*>&& sessions, WorldSessionUpdater& updater)
+            : _sessions(std::move(sessions)), _updater(updater)
+        {
+        }
+
+        void call()
+        {
+            for (WorldSession* session : _sessions)
+            {
+                // session timers are advanced by Map::Update(), only drain the thread-safe packets here
+                MapSessionFilter updater(session);
+                session->Update(0, updater);
+            }
+
+            _updater.UpdateFinished();
+        }
+};
+
+void WorldSessionUpdater::Activate(size_t numThreads)
+{
+    for (size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&WorldSessionUpdater::WorkerThread, this));
+}
+
+void WorldSessionUpdater::Deactivate()
+{
+    _cancelationToken = true;
+
+    Wait();
+
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+void WorldSessionUpdater::Wait()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    while (_pendingRequests > 0)
+        _condition.wait(lock);
+}
+
+void WorldSessionUpdater::ScheduleUpdate(std::vector<WorldSession*>&& sessions)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ++_pendingRequests;
+
+    _queue.Push(new WorldSessionUpdateRequest(std::move(sessions), *this));
+}
+
+void WorldSessionUpdater::UpdateFinished()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    --_pendingRequests;
+
+    _condition.notify_all();
+}
+
+void WorldSessionUpdater::WorkerThread()
+{
+    while (true)
+    {
+        WorldSessionUpdateRequest* request = nullptr;
+
+        _queue.WaitAndPop(request);
+
+        if (_cancelationToken)
+            return;
+
+        request->call();
+
+        delete request;
+    }
+}
@@ -0,0 +1,67 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _WORLD_SESSION_UPDATER_H_INCLUDED
+#define _WORLD_SESSION_UPDATER_H_INCLUDED
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorldSession;
+class WorldSessionUpdateRequest;
+
+// Processes the thread-safe packets of world sessions on a pool of worker threads.
+// Sessions are scheduled in batches, every session of a batch belongs to the same map
+// so the same rules as for packets processed in Map::Update() apply.
+class FC_GAME_API WorldSessionUpdater
+{
+    public:
+        WorldSessionUpdater() : _cancelationToken(false), _pendingRequests(0) { }
+        ~WorldSessionUpdater() { }
+
+        friend class WorldSessionUpdateRequest;
+
+        void ScheduleUpdate(std::vector<WorldSession*>&& sessions);
+
+        // blocks until every scheduled batch has been processed
+        void Wait();
+
+        void Activate(size_t numThreads);
+        void Deactivate();
+        bool Activated() const { return !_workerThreads.empty(); }
+
+    private:
+        ProducerConsumerQueue<WorldSessionUpdateRequest*> _queue;
+
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken;
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        size_t _pendingRequests;
+
+        void UpdateFinished();
+
+        void WorkerThread();
+};
+
+#endif // _WORLD_SESSION_UPDATER_H_INCLUDED
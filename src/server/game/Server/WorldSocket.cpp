@@ -28,6 +28,7 @@
 #include "DatabaseEnv.h"
 #include "GameTime.h"
 #include "IPLocation.h"
+#include "Metric.h"
 #include "Opcodes.h"
 #include "PacketLog.h"
 #include "QueryCallback.h"
@@ -111,31 +112,39 @@ bool WorldSocket::Update() {
   EncryptablePacket* queued;
   MessageBuffer buffer(_sendBufferSize);
   while (_bufferQueue.Dequeue(queued)) {
-    if (queued->size() > 0x400 && !queued->IsCompressed())
+    if (queued->GetPayload().size() > 0x400 &&
+        !queued->GetPayload().IsCompressed()) {
+      queued->Unshare();
       queued->Compress(_compressionStream);
+    }
 
-    ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+    WorldPacket const& payload = queued->GetPayload();
+    ServerPktHeader header(payload.size() + 2, payload.GetOpcode());
     if (queued->NeedsEncryption())
       _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
     if (buffer.GetRemainingSpace() <
-        queued->size() + header.getHeaderLength()) {
+        payload.size() + header.getHeaderLength()) {
       QueuePacket(std::move(buffer));
       buffer.Resize(_sendBufferSize);
     }
 
     if (buffer.GetRemainingSpace() >=
-        queued->size() + header.getHeaderLength()) {
+        payload.size() + header.getHeaderLength()) {
       buffer.Write(header.header, header.getHeaderLength());
-      if (!queued->empty()) buffer.Write(queued->contents(), queued->size());
-    } else  // single packet larger than 4096 bytes
+      if (!payload.empty()) buffer.Write(payload.contents(), payload.size());
+    } else  // single packet larger than the send buffer
     {
-      MessageBuffer packetBuffer(queued->size() + header.getHeaderLength());
-      packetBuffer.Write(header.header, header.getHeaderLength());
-      if (!queued->empty())
-        packetBuffer.Write(queued->contents(), queued->size());
+      // only the header is copied, the payload is handed to the socket as is
+      // and goes out in the same gathered write
+      buffer.Write(header.header, header.getHeaderLength());
+      QueuePacket(std::move(buffer));
+      buffer.Resize(_sendBufferSize);
 
-      QueuePacket(std::move(packetBuffer));
+      if (!payload.empty()) {
+        queued->Unshare();
+        QueuePacket(std::make_shared<std::vector<uint8> const>(queued->Move()));
+      }
     }
 
     delete queued;
@@ -168,6 +177,10 @@ void WorldSocket::OnClose() {
     std::lock_guard<std::mutex> sessionGuard(_worldSessionLock);
     _worldSession = nullptr;
   }
+
+  // bytes per write call shows how well outgoing packets were gathered
+  FC_METRIC_VALUE("socket_write_calls", GetWriteCallCount());
+  FC_METRIC_VALUE("socket_written_bytes", GetWrittenBytes());
 }
 
 void WorldSocket::ReadHandler() {
@@ -512,6 +525,17 @@ void WorldSocket::SendPacket(WorldPacket const& packet) {
       new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> packet) {
+  if (!IsOpen()) return;
+
+  if (sPacketLog->CanLogPacket())
+    sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(),
+                          GetRemotePort());
+
+  _bufferQueue.Enqueue(
+      new EncryptablePacket(std::move(packet), _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(
     std::shared_ptr<WorldPackets::Auth::AuthSession> authSession) {
   // Get the account information from the auth database
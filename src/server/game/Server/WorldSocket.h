@@ -41,11 +41,31 @@ class EncryptablePacket : public WorldPacket {
     SocketQueueLink.store(nullptr, std::memory_order_relaxed);
   }
 
+  // references the payload of a packet broadcast to several sockets instead
+  // of copying it, only the header is encrypted so it can be shared as is
+  EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt)
+      : WorldPacket(packet->GetOpcode(), 0),
+        _shared(std::move(packet)),
+        _encrypt(encrypt) {
+    SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+  }
+
   bool NeedsEncryption() const { return _encrypt; }
 
+  WorldPacket const& GetPayload() const { return _shared ? *_shared : *this; }
+
+  //! Replaces a shared payload with a private copy that can be modified
+  void Unshare() {
+    if (!_shared) return;
+
+    WorldPacket::operator=(*_shared);
+    _shared.reset();
+  }
+
   std::atomic<EncryptablePacket*> SocketQueueLink;
 
  private:
+  std::shared_ptr<WorldPacket const> _shared;
   bool _encrypt;
 };
 
@@ -91,6 +111,7 @@ class FC_GAME_API WorldSocket : public Socket<WorldSocket> {
   bool Update() override;
 
   void SendPacket(WorldPacket const& packet);
+  void SendPacket(std::shared_ptr<WorldPacket const> packet);
   void SetSendBufferSize(std::size_t sendBufferSize) {
     _sendBufferSize = sendBufferSize;
   }
@@ -17,11 +17,16 @@
 
 #include "WhoListStorage.h"
 #include "World.h"
+#include "AccountMgr.h"
+#include "DBCStores.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
 #include "GuildMgr.h"
 #include "WorldSession.h"
 
+// Bounds memory when addons flood distinct searches, the cache is dropped on every Update anyway
+static constexpr std::size_t MAX_CACHED_WHO_QUERIES = 256;
+
 WhoListStorageMgr* WhoListStorageMgr::instance()
 {
     static WhoListStorageMgr instance;
@@ -32,6 +37,13 @@ void WhoListStorageMgr::Update()
 {
     // clear current list
     _whoListStorage.clear();
+    _zoneIndex.clear();
+    _guidIndex.clear();
+    {
+        std::lock_guard<std::mutex> lock(_queryCacheLock);
+        _queryCache.clear();
+    }
+
     _whoListStorage.reserve(sWorld->GetPlayerCount()+1);
 
     HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
@@ -58,4 +70,128 @@ void WhoListStorageMgr::Update()
             itr->second->getClass(), itr->second->getRace(), itr->second->GetZoneId(), itr->second->GetByteValue(PLAYER_BYTES_3, PLAYER_BYTES_3_OFFSET_GENDER), itr->second->IsVisible(),
             widePlayerName, wideGuildName, playerName, guildName);
     }
+
+    std::stable_sort(_whoListStorage.begin(), _whoListStorage.end(), [](WhoListPlayerInfo const& left, WhoListPlayerInfo const& right)
+    {
+        return left.GetLevel() < right.GetLevel();
+    });
+
+    for (uint32 i = 0; i < _whoListStorage.size(); ++i)
+    {
+        _zoneIndex[_whoListStorage[i].GetZoneId()].push_back(i);
+        _guidIndex[_whoListStorage[i].GetGuid()] = i;
+    }
+}
+
+WhoListResult WhoListStorageMgr::Query(WhoListQuery query)
+{
+    // the searching player only differs from anyone else with the same security when it is invisible itself
+    auto viewerItr = _guidIndex.find(query.Viewer);
+    if (viewerItr == _guidIndex.end() || _whoListStorage[viewerItr->second].IsVisible())
+        query.Viewer.Clear();
+
+    std::sort(query.Areas.begin(), query.Areas.end());
+    query.Areas.erase(std::unique(query.Areas.begin(), query.Areas.end()), query.Areas.end());
+
+    {
+        std::lock_guard<std::mutex> lock(_queryCacheLock);
+        auto itr = _queryCache.find(query);
+        if (itr != _queryCache.end())
+            return itr->second;
+    }
+
+    WhoListResult result;
+    if (!query.Areas.empty())
+    {
+        std::vector<uint32> candidates;
+        for (int32 areaId : query.Areas)
+        {
+            auto itr = _zoneIndex.find(uint32(areaId));
+            if (itr != _zoneIndex.end())
+                candidates.insert(candidates.end(), itr->second.begin(), itr->second.end());
+        }
+
+        // keep the level ordering of a search without zones
+        std::sort(candidates.begin(), candidates.end());
+        for (uint32 index : candidates)
+        {
+            if (result.size() >= query.MaxResults)
+                break;
+
+            if (Matches(_whoListStorage[index], query))
+                result.push_back(&_whoListStorage[index]);
+        }
+    }
+    else
+    {
+        auto itr = std::lower_bound(_whoListStorage.begin(), _whoListStorage.end(), query.MinLevel, [](WhoListPlayerInfo const& target, int32 level)
+        {
+            return target.GetLevel() < level;
+        });
+
+        for (; itr != _whoListStorage.end() && itr->GetLevel() <= query.MaxLevel && result.size() < query.MaxResults; ++itr)
+            if (Matches(*itr, query))
+                result.push_back(&*itr);
+    }
+
+    std::lock_guard<std::mutex> lock(_queryCacheLock);
+    if (_queryCache.size() < MAX_CACHED_WHO_QUERIES)
+        _queryCache.emplace(std::move(query), result);
+
+    return result;
+}
+
+bool WhoListStorageMgr::Matches(WhoListPlayerInfo const& target, WhoListQuery const& query) const
+{
+    // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
+    if (query.Team && target.GetTeam() != query.Team)
+        return false;
+
+    // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
+    if (target.GetSecurity() > query.MaxVisibleSecurity)
+        return false;
+
+    // check if target is globally visible for player
+    if (query.Viewer != target.GetGuid() && !target.IsVisible())
+        if (AccountMgr::IsPlayerAccount(query.Security) || target.GetSecurity() > query.Security)
+            return false;
+
+    // check if target's level is in level range
+    uint8 lvl = target.GetLevel();
+    if (lvl < query.MinLevel || lvl > query.MaxLevel)
+        return false;
+
+    // check if class matches classmask
+    if (query.ClassFilter >= 0 && !(query.ClassFilter & (1 << target.GetClass())))
+        return false;
+
+    // check if race matches racemask
+    if (query.RaceFilter >= 0 && (query.RaceFilter & (1 << target.GetRace())))
+        return false;
+
+    if (!query.Areas.empty() && !std::binary_search(query.Areas.begin(), query.Areas.end(), int32(target.GetZoneId())))
+        return false;
+
+    std::wstring const& wTargetName = target.GetWidePlayerName();
+    if (!(query.PlayerName.empty() || wTargetName.find(query.PlayerName) != std::wstring::npos))
+        return false;
+
+    std::wstring const& wTargetGuildName = target.GetWideGuildName();
+    if (!query.GuildName.empty() && wTargetGuildName.find(query.GuildName) == std::wstring::npos)
+        return false;
+
+    if (!query.Words.empty())
+    {
+        std::string aName;
+        if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(target.GetZoneId()))
+            aName = areaEntry->AreaName[query.Locale];
+
+        for (std::wstring const& word : query.Words)
+            if (!word.empty() && (wTargetName.find(word) != std::wstring::npos || wTargetGuildName.find(word) != std::wstring::npos || Utf8FitTo(aName, word)))
+                return true;
+
+        return false;
+    }
+
+    return true;
 }
@@ -20,6 +20,9 @@
 
 #include "Common.h"
 #include "ObjectGuid.h"
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 class WhoListPlayerInfo
 {
@@ -60,6 +63,33 @@ private:
 };
 
 typedef std::vector<WhoListPlayerInfo> WhoListInfoVector;
+typedef std::vector<WhoListPlayerInfo const*> WhoListResult;
+
+// Everything the result of a who search depends on, names and words are expected lowercase
+struct WhoListQuery
+{
+    int32 MinLevel = 0;
+    int32 MaxLevel = 0;
+    int32 ClassFilter = -1;
+    int32 RaceFilter = -1;
+    std::vector<int32> Areas;
+    std::wstring PlayerName;
+    std::wstring GuildName;
+    std::vector<std::wstring> Words;
+    uint32 Team = 0;                                    // 0 lists both teams
+    AccountTypes MaxVisibleSecurity = SEC_PLAYER;       // highest security listed, invisible or not
+    AccountTypes Security = SEC_PLAYER;                 // security of the searching player
+    ObjectGuid Viewer;
+    LocaleConstant Locale = LOCALE_enUS;
+    uint32 MaxResults = 0;
+
+    bool operator<(WhoListQuery const& right) const
+    {
+        return std::tie(MinLevel, MaxLevel, ClassFilter, RaceFilter, Areas, PlayerName, GuildName, Words, Team, MaxVisibleSecurity, Security, Viewer, Locale, MaxResults) <
+            std::tie(right.MinLevel, right.MaxLevel, right.ClassFilter, right.RaceFilter, right.Areas, right.PlayerName, right.GuildName, right.Words, right.Team,
+                right.MaxVisibleSecurity, right.Security, right.Viewer, right.Locale, right.MaxResults);
+    }
+};
 
 class FC_GAME_API WhoListStorageMgr
 {
@@ -73,8 +103,21 @@ public:
     void Update();
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    // Searches the current snapshot, identical queries are answered from cache until the next Update.
+    // Safe to call from map threads, Update runs on the world thread while no map is updated.
+    WhoListResult Query(WhoListQuery query);
+
 protected:
-    WhoListInfoVector _whoListStorage;
+    WhoListInfoVector _whoListStorage;                  // sorted by level
+
+private:
+    bool Matches(WhoListPlayerInfo const& target, WhoListQuery const& query) const;
+
+    std::unordered_map<uint32 /*zoneId*/, std::vector<uint32>> _zoneIndex;
+    std::unordered_map<ObjectGuid, uint32> _guidIndex;
+
+    std::mutex _queryCacheLock;
+    std::map<WhoListQuery, WhoListResult> _queryCache;
 };
 
 #define sWhoListStorageMgr WhoListStorageMgr::instance()
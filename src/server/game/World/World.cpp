@@ -70,6 +70,7 @@
 #include "Player.h"
 #include "PlayerDump.h"
 #include "PoolMgr.h"
+#include "Profiler.h"
 #include "QueryCallback.h"
 #include "QuestPools.h"
 #include "Realm.h"
@@ -91,6 +92,7 @@
 #include "WeatherMgr.h"
 #include "WhoListStorage.h"
 #include "WorldSession.h"
+#include "WorldSessionUpdater.h"
 #include "WorldStateMgr.h"
 #include "WorldSocket.h"
 
@@ -111,7 +113,7 @@ FC_GAME_API int32 World::m_visibility_notify_periodInInstances  = DEFAULT_VISIBI
 FC_GAME_API int32 World::m_visibility_notify_periodInBGArenas   = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 
 /// World constructor
-World::World()
+World::World() : _sessionUpdater(std::make_unique<WorldSessionUpdater>())
 {
     m_playerLimit = 0;
     m_allowedSecurityLevel = SEC_PLAYER;
@@ -154,6 +156,9 @@ World::World()
 /// World destructor
 World::~World()
 {
+    if (_sessionUpdater->Activated())
+        _sessionUpdater->Deactivate();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -695,6 +700,12 @@ void World::LoadConfigSettings(bool reload)
         LOG_ERROR("server.loading", "Auction.SearchDelay (%i) must be between 100 and 10000. Using default of 300ms", m_int_configs[CONFIG_AUCTION_SEARCH_DELAY]);
         m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] = 300;
     }
+    m_int_configs[CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE] = sConfigMgr->GetIntDefault("Auction.SettlementBatchSize", 100);
+    if (m_int_configs[CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE] < 1)
+    {
+        LOG_ERROR("server.loading", "Auction.SettlementBatchSize (%i) must be greater than 0. Using default of 100", m_int_configs[CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE]);
+        m_int_configs[CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE] = 100;
+    }
     m_int_configs[CONFIG_CHAT_CHANNEL_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Channel", 1);
     m_int_configs[CONFIG_CHAT_WHISPER_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Whisper", 1);
     m_int_configs[CONFIG_CHAT_EMOTE_LEVEL_REQ] = sConfigMgr->GetIntDefault("ChatLevelReq.Emote", 1);
@@ -1362,6 +1373,7 @@ void World::LoadConfigSettings(bool reload)
     }
     // Respawn Settings
     m_int_configs[CONFIG_RESPAWN_MINCHECKINTERVALMS] = sConfigMgr->GetIntDefault("Respawn.MinCheckIntervalMS", 5000);
+    m_int_configs[CONFIG_RESPAWN_SAVEINTERVALMS] = sConfigMgr->GetIntDefault("Respawn.SaveIntervalMS", 10000);
     m_int_configs[CONFIG_RESPAWN_DYNAMICMODE] = sConfigMgr->GetIntDefault("Respawn.DynamicMode", 0);
     if (m_int_configs[CONFIG_RESPAWN_DYNAMICMODE] > 1)
     {
@@ -1466,6 +1478,12 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = sConfigMgr->GetIntDefault("SessionUpdate.Threads", 0);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS] = sConfigMgr->GetIntDefault("GridPreload.Threads", 0);
+    m_int_configs[CONFIG_GRID_PRELOAD_LOOKAHEAD] = sConfigMgr->GetIntDefault("GridPreload.LookAhead", 5000);
+    m_int_configs[CONFIG_CREATURE_UPDATE_INTERVAL_MOVING] = sConfigMgr->GetIntDefault("Creature.UpdateInterval.Moving", 0);
+    m_int_configs[CONFIG_CREATURE_UPDATE_INTERVAL_IDLE] = sConfigMgr->GetIntDefault("Creature.UpdateInterval.Idle", 0);
+    m_int_configs[CONFIG_MAP_CREATURE_UPDATE_BUDGET] = sConfigMgr->GetIntDefault("MapUpdate.CreatureBudget", 0);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1604,6 +1622,8 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_PACKET_SPOOF_BANMODE] = BAN_ACCOUNT;
 
     m_int_configs[CONFIG_PACKET_SPOOF_BANDURATION] = sConfigMgr->GetIntDefault("PacketSpoof.BanDuration", 86400);
+    m_int_configs[CONFIG_PACKET_SPOOF_MAX_SESSION_PACKETS] = sConfigMgr->GetIntDefault("PacketSpoof.MaxSessionPacketsPerSecond", 0);
+    m_int_configs[CONFIG_PACKET_SPOOF_MAX_HANDLER_TIME] = sConfigMgr->GetIntDefault("PacketSpoof.MaxHandlerTimePerSecond", 0);
 
     m_bool_configs[CONFIG_IP_BASED_ACTION_LOGGING] = sConfigMgr->GetBoolDefault("Allow.IP.Based.Action.Logging", false);
 
@@ -2289,6 +2309,9 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Starting Map System");
     sMapMgr->Initialize();
 
+    if (uint32 sessionUpdateThreads = getIntConfig(CONFIG_SESSION_UPDATE_THREADS))
+        _sessionUpdater->Activate(sessionUpdateThreads);
+
     LOG_INFO("server.loading", "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2405,6 +2428,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    FC_PROFILE_ZONE("World::Update");
+
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
     time_t currentGameTime = GameTime::GetGameTime();
@@ -2454,7 +2479,7 @@ void World::Update(uint32 diff)
             sObjectMgr->ReturnOrDeleteOldMails(true);
         }
 
-        ///- Handle expired auctions
+        ///- Queue expired auctions for settlement
         sAuctionMgr->Update();
     }
 
@@ -2463,6 +2488,9 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_AUCTIONS_PENDING].Reset();
 
         sAuctionMgr->UpdatePendingAuctions();
+
+        ///- Settle a batch of expired auctions
+        sAuctionMgr->UpdateSettlements();
     }
 
     /// <li> Handle AHBot operations
@@ -2525,6 +2553,9 @@ void World::Update(uint32 diff)
     sMapMgr->Update(diff);
     sWorldUpdateTime.RecordUpdateTimeDuration("UpdateMapMgr");
 
+    ///- No map or session update thread runs past this point, nothing can still be reading retired cache tables
+    sCharacterCache->ReleaseRetiredLookupTables();
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2610,6 +2641,8 @@ void World::Update(uint32 diff)
     // Stats logger update
     sMetric->Update();
     FC_METRIC_VALUE("update_time_diff", diff);
+    FC_METRIC_VALUE("bytebuffer_heap_allocations", ByteBuffer::ConsumeHeapAllocationCount());
+    FC_METRIC_VALUE("bytebuffer_pool_reuses", ByteBuffer::ConsumePoolReuseCount());
 }
 
 void World::ForceGameEventUpdate()
@@ -3126,6 +3159,8 @@ void World::SendServerMessage(ServerMessageType type, const char *text, Player*
 
 void World::UpdateSessions(uint32 diff)
 {
+    FC_PROFILE_ZONE("World::UpdateSessions");
+
     std::pair<std::weak_ptr<WorldSocket>, uint64> linkInfo;
     while (_linkSocketQueue.next(linkInfo))
         ProcessLinkInstanceSocket(std::move(linkInfo));
@@ -3135,7 +3170,26 @@ void World::UpdateSessions(uint32 diff)
     while (addSessQueue.next(sess))
         AddSession_(sess);
 
+    ///- Process thread-safe packets of players in world on the session update threads, grouped by map
+    ///  so that each group follows the same rules as in Map::Update(). Everything else is processed below,
+    ///  the queue filters stop at the first packet they do not accept so the packet order of a session is kept.
+    if (_sessionUpdater->Activated())
+    {
+        std::unordered_map<Map*, std::vector<WorldSession*>> sessionsByMap;
+        for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+            if (Player* player = itr->second->GetPlayer())
+                if (player->IsInWorld() && !itr->second->PlayerLogout())
+                    sessionsByMap[player->GetMap()].push_back(itr->second);
+
+        for (auto& mapSessions : sessionsByMap)
+            _sessionUpdater->ScheduleUpdate(std::move(mapSessions.second));
+
+        _sessionUpdater->Wait();
+    }
+
     ///- Then send an update signal to remaining ones
+    std::size_t maxRecvQueueSize = 0;
+    std::size_t totalRecvQueueSize = 0;
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
         next = itr;
@@ -3145,6 +3199,10 @@ void World::UpdateSessions(uint32 diff)
         WorldSession* pSession = itr->second;
         WorldSessionFilter updater(pSession);
 
+        std::size_t recvQueueSize = pSession->GetRecvQueueSize();
+        maxRecvQueueSize = std::max(maxRecvQueueSize, recvQueueSize);
+        totalRecvQueueSize += recvQueueSize;
+
         if (!pSession->Update(diff, updater))    // As interval = 0
         {
             if (!RemoveQueuedPlayer(itr->second) && itr->second && getIntConfig(CONFIG_INTERVAL_DISCONNECT_TOLERANCE))
@@ -3155,6 +3213,10 @@ void World::UpdateSessions(uint32 diff)
 
         }
     }
+
+    // aggregated over all sessions, a tag per account would create a series for every account
+    FC_METRIC_VALUE("session_recv_queue_depth_max", uint64(maxRecvQueueSize));
+    FC_METRIC_VALUE("session_recv_queue_depth_total", uint64(totalRecvQueueSize));
 }
 
 // This handles the issued and queued CLI commands
@@ -3674,6 +3736,8 @@ uint64 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
+    FC_PROFILE_ZONE("World::ProcessQueryCallbacks");
+
     _queryProcessor.ProcessReadyCallbacks();
 }
 
@@ -33,11 +33,13 @@
 #include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 class Player;
 class WorldPacket;
 class WorldSession;
+class WorldSessionUpdater;
 class WorldSocket;
 struct Realm;
 
@@ -365,6 +367,12 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_SESSION_UPDATE_THREADS,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_CREATURE_UPDATE_INTERVAL_MOVING,
+    CONFIG_CREATURE_UPDATE_INTERVAL_IDLE,
+    CONFIG_MAP_CREATURE_UPDATE_BUDGET,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -424,6 +432,8 @@ enum WorldIntConfigs
     CONFIG_PACKET_SPOOF_POLICY,
     CONFIG_PACKET_SPOOF_BANMODE,
     CONFIG_PACKET_SPOOF_BANDURATION,
+    CONFIG_PACKET_SPOOF_MAX_SESSION_PACKETS,
+    CONFIG_PACKET_SPOOF_MAX_HANDLER_TIME,
     CONFIG_ACC_PASSCHANGESEC,
     CONFIG_BG_REWARD_WINNER_HONOR_FIRST,
     CONFIG_BG_REWARD_WINNER_HONOR_LAST,
@@ -442,8 +452,10 @@ enum WorldIntConfigs
     CONFIG_NO_GRAY_AGGRO_BELOW,
     CONFIG_AUCTION_GETALL_DELAY,
     CONFIG_AUCTION_SEARCH_DELAY,
+    CONFIG_AUCTION_SETTLEMENT_BATCH_SIZE,
     CONFIG_TALENTS_INSPECTING,
     CONFIG_RESPAWN_MINCHECKINTERVALMS,
+    CONFIG_RESPAWN_SAVEINTERVALMS,
     CONFIG_RESPAWN_DYNAMICMODE,
     CONFIG_RESPAWN_GUIDWARNLEVEL,
     CONFIG_RESPAWN_GUIDALERTLEVEL,
@@ -879,6 +891,7 @@ class FC_GAME_API World
         time_t mail_timer_expires;
 
         SessionMap m_sessions;
+        std::unique_ptr<WorldSessionUpdater> _sessionUpdater;
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
         uint32 m_maxActiveSessionCount;
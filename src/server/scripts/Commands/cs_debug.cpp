@@ -29,6 +29,7 @@ EndScriptData */
 #include "CellImpl.h"
 #include "Chat.h"
 #include "DBCStores.h"
+#include "GameTime.h"
 #include "GossipDef.h"
 #include "GridNotifiersImpl.h"
 #include "InstanceScript.h"
@@ -40,6 +41,7 @@ EndScriptData */
 #include "ObjectMgr.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
+#include "Profiler.h"
 #include "QuestPools.h"
 #include "RBAC.h"
 #include "SpellMgr.h"
@@ -78,6 +80,12 @@ public:
             { "setphaseshift", rbac::RBAC_PERM_COMMAND_DEBUG_SEND_SETPHASESHIFT, false, &HandleDebugSendSetPhaseShiftCommand,   "" },
             { "spellfail",     rbac::RBAC_PERM_COMMAND_DEBUG_SEND_SPELLFAIL,     false, &HandleDebugSendSpellFailCommand,       "" },
         };
+        static std::vector<ChatCommand> debugProfilerCommandTable =
+        {
+            { "start",         rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,         true,  &HandleDebugProfilerStartCommand,       "" },
+            { "stop",          rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,         true,  &HandleDebugProfilerStopCommand,        "" },
+            { "dump",          rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,         true,  &HandleDebugProfilerDumpCommand,        "" },
+        };
         static std::vector<ChatCommand> debugCommandTable =
         {
             { "setbit",        rbac::RBAC_PERM_COMMAND_DEBUG_SETBIT,        false, &HandleDebugSet32BitCommand,         "" },
@@ -112,6 +120,7 @@ public:
             { "boundary",      rbac::RBAC_PERM_COMMAND_DEBUG_BOUNDARY,      false, &HandleDebugBoundaryCommand,         "" },
             { "raidreset",     rbac::RBAC_PERM_COMMAND_INSTANCE_UNBIND,     false, &HandleDebugRaidResetCommand,        "" },
             { "neargraveyard", rbac::RBAC_PERM_COMMAND_NEARGRAVEYARD,       false, &HandleDebugNearGraveyard,           "" },
+            { "profiler",      rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true,  nullptr,                             "", debugProfilerCommandTable },
         };
         static std::vector<ChatCommand> commandTable =
         {
@@ -1757,6 +1766,63 @@ public:
 
         return true;
     }
+
+    // .debug profiler start [zones per thread]
+    static bool HandleDebugProfilerStartCommand(ChatHandler* handler, char const* args)
+    {
+        if (!Profiler::IsCompiledIn())
+        {
+            handler->SendSysMessage("Profiler zones are not compiled in, rebuild with -DWITH_PROFILER=1.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        uint32 zonesPerThread = Profiler::DEFAULT_ZONES_PER_THREAD;
+        if (*args)
+            zonesPerThread = std::max<uint32>(atoul(args), 1);
+
+        sProfiler->Start(zonesPerThread);
+        handler->PSendSysMessage("Profiler started, keeping the last %u zones of every thread.", zonesPerThread);
+        return true;
+    }
+
+    static bool HandleDebugProfilerStopCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sProfiler->Stop();
+        handler->SendSysMessage("Profiler stopped.");
+        return true;
+    }
+
+    // .debug profiler dump [file name], written to the logs directory, recording continues if started
+    static bool HandleDebugProfilerDumpCommand(ChatHandler* handler, char const* args)
+    {
+        std::string fileName;
+        if (*args)
+        {
+            fileName = args;
+            // only a bare file name, never a path out of the logs directory
+            if (fileName.find_first_of("/\\") != std::string::npos || fileName.find("..") != std::string::npos)
+            {
+                handler->SendSysMessage("The profile file name must not contain path separators or '..'.");
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+        }
+        else
+            fileName = Firelands::StringFormat("profile-%u.json", uint32(GameTime::GetGameTime()));
+
+        fileName = sLog->GetLogsDir() + fileName;
+
+        if (!sProfiler->DumpChromeTrace(fileName))
+        {
+            handler->PSendSysMessage("Could not write profile to %s.", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Profile written to %s, open it in chrome://tracing or ui.perfetto.dev.", fileName.c_str());
+        return true;
+    }
 };
 
 void AddSC_debug_commandscript()
@@ -20,16 +20,21 @@
 
 #include "MessageBuffer.h"
 #include "Log.h"
+#include <algorithm>
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <type_traits>
+#include <vector>
 #include <boost/asio/ip/tcp.hpp>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+// upper limits for gathering queued buffers into a single write call
+#define WRITE_GATHER_MAX_BUFFERS 64
+#define WRITE_GATHER_MAX_BYTES 0x10000
 #ifdef BOOST_ASIO_HAS_IOCP
 #define FC_SOCKET_USE_IOCP
 #endif
@@ -39,9 +44,11 @@ class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false),
+        _writeCalls(0), _writtenBytes(0)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
+        _gatherBuffers.reserve(WRITE_GATHER_MAX_BUFFERS);
     }
 
     virtual ~Socket()
@@ -103,7 +110,20 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.emplace_back(std::move(buffer));
+
+#ifdef FC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
+    /// Queues a read only payload without copying it, the same payload can be queued on any number of sockets
+    void QueuePacket(std::shared_ptr<std::vector<uint8> const> payload)
+    {
+        if (payload->empty())
+            return;
+
+        _writeQueue.emplace_back(std::move(payload));
 
 #ifdef FC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -131,6 +151,10 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    /// Number of write calls issued and bytes sent since the socket was opened
+    uint64 GetWriteCallCount() const { return _writeCalls; }
+    uint64 GetWrittenBytes() const { return _writtenBytes; }
+
 protected:
     virtual void OnClose() { }
 
@@ -144,8 +168,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef FC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        GatherWriteQueue();
+        ++_writeCalls;
+        _socket.async_write_some(_gatherBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -165,6 +190,63 @@ protected:
     }
 
 private:
+    /// Outgoing data, either a buffer owned by this socket or a payload shared with other sockets
+    class QueuedBuffer
+    {
+    public:
+        explicit QueuedBuffer(MessageBuffer&& buffer) : _buffer(std::move(buffer)), _sharedReadPos(0) { }
+        explicit QueuedBuffer(std::shared_ptr<std::vector<uint8> const> payload) : _buffer(0), _shared(std::move(payload)), _sharedReadPos(0) { }
+
+        uint8 const* GetReadPointer() { return _shared ? _shared->data() + _sharedReadPos : _buffer.GetReadPointer(); }
+
+        std::size_t GetActiveSize() const { return _shared ? _shared->size() - _sharedReadPos : _buffer.GetActiveSize(); }
+
+        void ReadCompleted(std::size_t bytes)
+        {
+            if (_shared)
+                _sharedReadPos += bytes;
+            else
+                _buffer.ReadCompleted(bytes);
+        }
+
+    private:
+        MessageBuffer _buffer;
+        std::shared_ptr<std::vector<uint8> const> _shared;
+        std::size_t _sharedReadPos;
+    };
+
+    /// Collects the front of the write queue into _gatherBuffers, always takes at least one buffer
+    std::size_t GatherWriteQueue()
+    {
+        _gatherBuffers.clear();
+        std::size_t bytesToSend = 0;
+        for (QueuedBuffer& queued : _writeQueue)
+        {
+            if (_gatherBuffers.size() >= WRITE_GATHER_MAX_BUFFERS || (bytesToSend && bytesToSend + queued.GetActiveSize() > WRITE_GATHER_MAX_BYTES))
+                break;
+
+            _gatherBuffers.emplace_back(queued.GetReadPointer(), queued.GetActiveSize());
+            bytesToSend += queued.GetActiveSize();
+        }
+
+        return bytesToSend;
+    }
+
+    /// Drops fully sent buffers from the write queue and advances a partially sent one
+    void ConsumeWriteQueue(std::size_t bytesSent)
+    {
+        _writtenBytes += bytesSent;
+        while (bytesSent && !_writeQueue.empty())
+        {
+            QueuedBuffer& queued = _writeQueue.front();
+            std::size_t consumed = std::min(bytesSent, queued.GetActiveSize());
+            queued.ReadCompleted(consumed);
+            bytesSent -= consumed;
+            if (!queued.GetActiveSize())
+                _writeQueue.pop_front();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -184,9 +266,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            ConsumeWriteQueue(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -210,37 +290,34 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteQueue();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        ++_writeCalls;
+        std::size_t bytesSent = _socket.write_some(_gatherBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        ConsumeWriteQueue(bytesSent);
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -254,12 +331,16 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<QueuedBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _gatherBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
 
     bool _isWritingAsync;
+
+    uint64 _writeCalls;
+    uint64 _writtenBytes;
 };
 
 #endif // __SOCKET_H__
@@ -21,13 +21,229 @@
 #include "Common.h"
 #include "Log.h"
 #include "Util.h"
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <sstream>
 #include <ctime>
 
-ByteBuffer::ByteBuffer(MessageBuffer&& buffer) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storage(buffer.Move())
+ByteBuffer::ByteBuffer(MessageBuffer&& buffer) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storagePool(nullptr), _storage(buffer.Move())
 {
 }
 
+namespace
+{
+    // Packets are built and destroyed on the same threads over and over (map updaters, session updaters, network threads),
+    // so released storage is kept in per-thread free lists bucketed by capacity instead of going back to the heap
+    struct StorageSizeClass
+    {
+        size_t Capacity;
+        size_t MaxPooled;
+    };
+
+    constexpr std::array<StorageSizeClass, 5> StorageSizeClasses =
+    { {
+        { 0x100,   256 },
+        { 0x400,   128 },
+        { 0x1000,  64 },
+        { 0x4000,  16 },
+        { 0x10000, 4 }
+    } };
+
+    constexpr size_t NoSizeClass = StorageSizeClasses.size();
+
+    size_t GetSizeClassForCapacity(size_t capacity)
+    {
+        if (capacity > StorageSizeClasses.back().Capacity * 2)
+            return NoSizeClass;
+
+        for (size_t i = StorageSizeClasses.size(); i > 0; --i)
+            if (capacity >= StorageSizeClasses[i - 1].Capacity)
+                return i - 1;
+
+        return NoSizeClass;
+    }
+
+    std::atomic<uint32> StorageHeapAllocations(0);
+    std::atomic<uint32> StoragePoolReuses(0);
+}
+
+/// Free lists of one thread. Packets are often freed on another thread than the one that
+/// built them (a copy queued to a socket is freed by the network thread), such storage is
+/// handed back through a locked return list that the owning thread takes over whenever its
+/// own free list of that size runs empty.
+class ByteBufferStoragePool
+{
+    typedef std::array<std::vector<std::vector<uint8>>, StorageSizeClasses.size()> FreeLists;
+
+public:
+    /// Owning thread only
+    std::vector<uint8> Acquire(size_t reserve)
+    {
+        for (size_t i = 0; i < StorageSizeClasses.size(); ++i)
+        {
+            if (reserve > StorageSizeClasses[i].Capacity)
+                continue;
+
+            std::vector<std::vector<uint8>>& freeList = _freeLists[i];
+            if (freeList.empty())
+            {
+                std::lock_guard<std::mutex> lock(_returnedLock);
+                freeList.swap(_returned[i]);
+            }
+
+            if (!freeList.empty())
+            {
+                std::vector<uint8> storage = std::move(freeList.back());
+                freeList.pop_back();
+                StoragePoolReuses.fetch_add(1, std::memory_order_relaxed);
+                return storage;
+            }
+
+            // round up so the storage can be pooled again when released
+            reserve = StorageSizeClasses[i].Capacity;
+            break;
+        }
+
+        std::vector<uint8> storage;
+        storage.reserve(reserve);
+        StorageHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return storage;
+    }
+
+    /// Owning thread only
+    void Release(std::vector<uint8>&& storage)
+    {
+        size_t sizeClass = GetSizeClassForCapacity(storage.capacity());
+        if (sizeClass == NoSizeClass)
+            return;
+
+        std::vector<std::vector<uint8>>& freeList = _freeLists[sizeClass];
+        if (freeList.size() < StorageSizeClasses[sizeClass].MaxPooled)
+        {
+            storage.clear();
+            freeList.push_back(std::move(storage));
+        }
+    }
+
+    /// Any other thread
+    void Return(std::vector<uint8>&& storage)
+    {
+        size_t sizeClass = GetSizeClassForCapacity(storage.capacity());
+        if (sizeClass == NoSizeClass)
+            return;
+
+        std::lock_guard<std::mutex> lock(_returnedLock);
+        std::vector<std::vector<uint8>>& returned = _returned[sizeClass];
+        if (returned.size() < StorageSizeClasses[sizeClass].MaxPooled)
+        {
+            storage.clear();
+            returned.push_back(std::move(storage));
+        }
+    }
+
+private:
+    FreeLists _freeLists;
+    std::mutex _returnedLock;
+    FreeLists _returned;
+};
+
+namespace
+{
+    // Pools are never destroyed, storage may still point to the pool of a thread that exited.
+    // Such pools are handed to the next thread needing one instead
+    std::mutex OrphanedStoragePoolsLock;
+    std::vector<ByteBufferStoragePool*> OrphanedStoragePools;
+
+    thread_local ByteBufferStoragePool* CurrentStoragePool = nullptr;
+    thread_local bool StoragePoolOrphaned = false;
+
+    struct ThreadStoragePool
+    {
+        ThreadStoragePool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(OrphanedStoragePoolsLock);
+                if (!OrphanedStoragePools.empty())
+                {
+                    CurrentStoragePool = OrphanedStoragePools.back();
+                    OrphanedStoragePools.pop_back();
+                }
+            }
+
+            if (!CurrentStoragePool)
+                CurrentStoragePool = new ByteBufferStoragePool();
+        }
+
+        ~ThreadStoragePool()
+        {
+            // storage released by this thread from now on is returned like from any other thread
+            ByteBufferStoragePool* pool = CurrentStoragePool;
+            CurrentStoragePool = nullptr;
+            StoragePoolOrphaned = true;
+
+            std::lock_guard<std::mutex> lock(OrphanedStoragePoolsLock);
+            OrphanedStoragePools.push_back(pool);
+        }
+    };
+
+    ByteBufferStoragePool* GetThreadStoragePool()
+    {
+        // don't resurrect the pool while the thread is shutting down
+        if (StoragePoolOrphaned)
+            return nullptr;
+
+        thread_local ThreadStoragePool threadPool;
+        return CurrentStoragePool;
+    }
+}
+
+std::vector<uint8> ByteBuffer::AcquireStorage(size_t reserve, ByteBufferStoragePool*& pool)
+{
+    pool = nullptr;
+    if (!reserve)
+        return std::vector<uint8>();
+
+    pool = GetThreadStoragePool();
+    if (!pool)
+    {
+        std::vector<uint8> storage;
+        storage.reserve(reserve);
+        StorageHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return storage;
+    }
+
+    return pool->Acquire(reserve);
+}
+
+void ByteBuffer::ReleaseStorage(std::vector<uint8>&& storage, ByteBufferStoragePool* pool)
+{
+    if (!storage.capacity())
+        return;
+
+    // storage that did not come from a pool (e.g. received packets) goes to the releasing thread's pool, if it has one
+    if (!pool)
+        pool = CurrentStoragePool;
+
+    if (!pool)
+        return;
+
+    if (pool == CurrentStoragePool)
+        pool->Release(std::move(storage));
+    else
+        pool->Return(std::move(storage));
+}
+
+uint32 ByteBuffer::ConsumeHeapAllocationCount()
+{
+    return StorageHeapAllocations.exchange(0, std::memory_order_relaxed);
+}
+
+uint32 ByteBuffer::ConsumePoolReuseCount()
+{
+    return StoragePoolReuses.exchange(0, std::memory_order_relaxed);
+}
+
 ByteBufferPositionException::ByteBufferPositionException(bool add, size_t pos,
                                                          size_t size, size_t valueSize)
 {
@@ -24,6 +24,7 @@
 #include <vector>
 #include <cstring>
 
+class ByteBufferStoragePool;
 class MessageBuffer;
 
 // Root of ByteBuffer exception hierarchy
@@ -64,25 +65,22 @@ class FC_SHARED_API ByteBuffer
         static uint8 const InitialBitPos = 8;
 
         // constructor
-        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
-        {
-            _storage.reserve(DEFAULT_SIZE);
-        }
+        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storagePool(nullptr), _storage(AcquireStorage(DEFAULT_SIZE, _storagePool)) { }
 
-        ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
-        {
-            _storage.reserve(reserve);
-        }
+        ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storagePool(nullptr), _storage(AcquireStorage(reserve, _storagePool)) { }
 
         ByteBuffer(ByteBuffer&& buf) noexcept : _rpos(buf._rpos), _wpos(buf._wpos),
-            _bitpos(buf._bitpos), _curbitval(buf._curbitval), _storage(std::move(buf._storage))
+            _bitpos(buf._bitpos), _curbitval(buf._curbitval), _storagePool(buf._storagePool), _storage(std::move(buf._storage))
         {
             buf._rpos = 0;
             buf._wpos = 0;
         }
 
         ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos),
-            _bitpos(right._bitpos), _curbitval(right._curbitval), _storage(right._storage) { }
+            _bitpos(right._bitpos), _curbitval(right._curbitval), _storagePool(nullptr), _storage(AcquireStorage(right._storage.size(), _storagePool))
+        {
+            _storage = right._storage;
+        }
 
         ByteBuffer(MessageBuffer&& buffer);
 
@@ -108,13 +106,23 @@ class FC_SHARED_API ByteBuffer
                 right._rpos = 0;
                 _wpos = right._wpos;
                 right._wpos = 0;
+                ReleaseStorage(std::move(_storage), _storagePool);
+                _storagePool = right._storagePool;
                 _storage = std::move(right._storage);
             }
 
             return *this;
         }
 
-        virtual ~ByteBuffer() { }
+        virtual ~ByteBuffer()
+        {
+            ReleaseStorage(std::move(_storage), _storagePool);
+        }
+
+        //! Number of storage heap allocations (pool misses) since the last call
+        static uint32 ConsumeHeapAllocationCount();
+        //! Number of storage requests served from the pool since the last call
+        static uint32 ConsumePoolReuseCount();
 
         void clear()
         {
@@ -122,6 +130,15 @@ class FC_SHARED_API ByteBuffer
             _rpos = _wpos = 0;
         }
 
+        //! Hands over the underlying storage, leaving this buffer empty
+        std::vector<uint8>&& Move() noexcept
+        {
+            _rpos = _wpos = 0;
+            _bitpos = InitialBitPos;
+            _curbitval = 0;
+            return std::move(_storage);
+        }
+
         template <typename T> void append(T value)
         {
             static_assert(std::is_fundamental<T>::value, "append(compound)");
@@ -612,9 +629,19 @@ class FC_SHARED_API ByteBuffer
 
         void hexlike() const;
 
+    private:
+        //! Returns an empty vector with at least the requested capacity, reusing a previously
+        //! released one from the calling thread's size-class pool if possible. pool is set to
+        //! the pool the storage has to be released to
+        static std::vector<uint8> AcquireStorage(size_t reserve, ByteBufferStoragePool*& pool);
+        //! Returns storage to the pool it was acquired from, even when released on another thread,
+        //! or frees it when it does not fit any size class
+        static void ReleaseStorage(std::vector<uint8>&& storage, ByteBufferStoragePool* pool);
+
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
+        ByteBufferStoragePool* _storagePool;
         std::vector<uint8> _storage;
 };
 
@@ -20,8 +20,10 @@
 /// @{
 /// \file
 
+#include "AchievementMgr.h"
 #include "AppenderDB.h"
 #include "AsyncAcceptor.h"
+#include "AuctionHouseMgr.h"
 #include "Banner.h"
 #include "BattlegroundMgr.h"
 #include "BigNumber.h"
@@ -41,9 +43,11 @@
 #include "ModulesScriptLoader.h"
 #include "MySQLThreading.h"
 #include "ObjectAccessor.h"
+#include "Opcodes.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
 #include "ProcessPriority.h"
+#include "Profiler.h"
 #include "RASession.h"
 #include "RealmList.h"
 #include "Resolver.h"
@@ -51,6 +55,7 @@
 #include "ScriptMgr.h"
 #include "ScriptReloadMgr.h"
 #include "World.h"
+#include "WorldSession.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
 #include <boost/asio/signal_set.hpp>
@@ -275,7 +280,15 @@ extern int main(int argc, char **argv)
 
     LoadRealmInfo(*ioContext);
 
-    sMetric->Initialize(realm.Name, *ioContext, []() { FC_METRIC_VALUE("online_players", sWorld->GetPlayerCount()); });
+    sMetric->Initialize(realm.Name, *ioContext, []()
+    {
+        FC_METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+        sAchievementMgr->LogCriteriaMetrics();
+        sMapMgr->GetGridPreloader()->LogMetrics();
+        opcodeTable.LogMetrics();
+        WorldSession::LogLoginMetrics();
+        sAuctionMgr->LogMetrics();
+    });
 
     FC_METRIC_EVENT("events", "Worldserver started", "");
 
@@ -479,6 +492,8 @@ void WorldUpdateLoop()
     uint32 realCurrTime = 0;
     uint32 realPrevTime = getMSTime();
 
+    sProfiler->SetThreadName("World");
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
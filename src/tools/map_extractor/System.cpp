@@ -15,7 +15,10 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "ProducerConsumerQueue.h"
 #include "StringFormat.h"
+#include "Timer.h"
+#include <atomic>
 #include <bitset>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
@@ -25,6 +28,7 @@
 #include <deque>
 #include <fstream>
 #include <set>
+#include <thread>
 #include <unordered_map>
 
 #include "Common.h"
@@ -126,6 +130,12 @@ float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - l
 
 uint32 CONF_TargetBuild = 15595; // 4.3.4.15595
 
+// Number of threads converting map tiles
+uint32 CONF_threads = std::max(1u, std::thread::hardware_concurrency());
+
+// Skip map tiles that were already extracted for the same build
+bool CONF_resume = false;
+
 // List MPQ for extract maps from
 char const* CONF_mpq_list[] = {
     "world.MPQ",
@@ -201,8 +211,10 @@ void Usage(char const* prg)
            "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"
            "-f height stored as int (less map size but lost some accuracy) 1 by default\n"
            "-b target build (default %u)\n"
+           "-t number of threads converting map tiles (default %u)\n"
+           "-r skip map tiles already extracted for the same build 0 by default\n"
            "Example: %s -f 0 -i \"c:\\games\\game\"",
-        prg, CONF_TargetBuild, prg);
+        prg, CONF_TargetBuild, CONF_threads, prg);
     exit(1);
 }
 
@@ -216,6 +228,8 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - number of threads
+        // r - resume, skip up to date map tiles
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -255,6 +269,18 @@ void HandleArgs(int argc, char* arg[])
             else
                 Usage(arg[0]);
             break;
+        case 't':
+            if (c + 1 < argc) // all ok
+                CONF_threads = std::max(1, atoi(arg[c++ + 1]));
+            else
+                Usage(arg[0]);
+            break;
+        case 'r':
+            if (c + 1 < argc) // all ok
+                CONF_resume = atoi(arg[c++ + 1]) != 0;
+            else
+                Usage(arg[0]);
+            break;
         default:
             break;
         }
@@ -495,24 +521,24 @@ struct map_liquidHeader
 float selectUInt8StepStore(float maxDiff) { return 255 / maxDiff; }
 
 float selectUInt16StepStore(float maxDiff) { return 65535 / maxDiff; }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8 uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8 uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8 uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8 uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 LiquidVertexFormatType adt_MH2O::GetLiquidVertexFormat(adt_liquid_instance const* liquidInstance) const
 {
@@ -1028,10 +1054,12 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     }
 
     // Ok all data prepared - store it
-    std::ofstream outFile(outputPath, std::ofstream::out | std::ofstream::binary);
+    // write to a temporary file first so an interrupted run never leaves a truncated tile behind
+    std::string tempPath = outputPath + ".tmp";
+    std::ofstream outFile(tempPath, std::ofstream::out | std::ofstream::binary);
     if (!outFile)
     {
-        printf("Can't create the output file '%s'\n", outputPath.c_str());
+        printf("Can't create the output file '%s'\n", tempPath.c_str());
         return false;
     }
 
@@ -1091,9 +1119,38 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
 
     outFile.close();
 
+    boost::system::error_code error;
+    if (!outFile)
+    {
+        printf("Can't write the output file '%s'\n", tempPath.c_str());
+        boost::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    boost::filesystem::rename(tempPath, outputPath, error);
+    if (error)
+    {
+        printf("Can't move '%s' to '%s': %s\n", tempPath.c_str(), outputPath.c_str(), error.message().c_str());
+        boost::filesystem::remove(tempPath, error);
+        return false;
+    }
+
     return true;
 }
 
+bool IsTileUpToDate(std::string const& outputPath, uint32 build)
+{
+    std::ifstream tile(outputPath, std::ifstream::in | std::ifstream::binary);
+    if (!tile)
+        return false;
+
+    map_fileheader header;
+    if (!tile.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return false;
+
+    return header.mapMagic == *reinterpret_cast<uint32 const*>(MAP_MAGIC) && header.versionMagic == MAP_VERSION_MAGIC && header.buildMagic == build;
+}
+
 bool IsDeepWaterIgnored(uint32 mapId, uint32 x, uint32 y)
 {
     if (mapId == 0)
@@ -1121,10 +1178,15 @@ bool IsDeepWaterIgnored(uint32 mapId, uint32 x, uint32 y)
     return false;
 }
 
+struct MapTileTask
+{
+    uint32 MapIndex;
+    uint32 X;
+    uint32 Y;
+};
+
 void ExtractMapsFromMpq(uint32 build)
 {
-    char mpq_filename[1024];
-    char output_filename[1024];
     char mpq_map_name[1024];
 
     printf("Extracting maps...\n");
@@ -1139,42 +1201,91 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    uint32 stageStart = getMSTime();
+
+    // tile conversion results, one byte per tile so worker threads never share a word
+    std::vector<std::vector<uint8>> existingTiles(map_count, std::vector<uint8>(WDT_MAP_SIZE * WDT_MAP_SIZE, 0));
+    ProducerConsumerQueue<MapTileTask> queue;
+    uint32 taskCount = 0;
+
+    printf("Read map grid lists\n");
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
         // Loadup map grid data
         sprintf(mpq_map_name, "World\\Maps\\%s\\%s.wdt", map_ids[z].name, map_ids[z].name);
         ChunkedFile wdt;
+        if (!wdt.loadFile(WorldMpq, mpq_map_name, false))
+            continue;
 
-        std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)> existingTiles;
-        if (wdt.loadFile(WorldMpq, mpq_map_name, false))
+        FileChunk* main = wdt.GetChunk("MAIN");
+        for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
         {
-            FileChunk* main = wdt.GetChunk("MAIN");
-            for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
+            for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
             {
-                for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
-                {
-                    if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
-                        continue;
+                if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
+                    continue;
 
-                    sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                    sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                    bool ignoreDeepWater = IsDeepWaterIgnored(map_ids[z].id, y, x);
-                    existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(mpq_filename, output_filename, y, x, build, ignoreDeepWater);
+                queue.Push({ z, x, y });
+                ++taskCount;
+            }
+        }
+    }
+
+    printf("Found %u map tiles in %u maps in %u ms\n", taskCount, map_count, GetMSTimeDiffToNow(stageStart));
+
+    stageStart = getMSTime();
+    uint32 threadCount = std::min(CONF_threads, std::max(taskCount, 1u));
+    printf("Convert map files using %u threads\n", threadCount);
+
+    std::atomic<uint32> doneTasks(0);
+    std::atomic<uint32> skippedTasks(0);
+    std::vector<std::thread> workers;
+    for (uint32 i = 0; i < threadCount; ++i)
+    {
+        workers.emplace_back([&]()
+        {
+            MapTileTask task;
+            while (queue.Pop(task))
+            {
+                map_id const& map = map_ids[task.MapIndex];
+                std::string mpqFileName = Firelands::StringFormat("World\\Maps\\%s\\%s_%u_%u.adt", map.name, map.name, task.X, task.Y);
+                std::string outputFileName = Firelands::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map.id, task.Y, task.X);
+
+                bool converted;
+                if (CONF_resume && IsTileUpToDate(outputFileName, build))
+                {
+                    converted = true;
+                    ++skippedTasks;
                 }
+                else
+                    converted = ConvertADT(mpqFileName, outputFileName, task.Y, task.X, build, IsDeepWaterIgnored(map.id, task.Y, task.X));
+
+                existingTiles[task.MapIndex][task.Y * WDT_MAP_SIZE + task.X] = converted ? 1 : 0;
 
-                // draw progress bar
-                printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
+                uint32 done = ++doneTasks;
+                if (done % 64 == 0 || done == taskCount)
+                    printf("Processing........................%u%%\r", (100 * done) / taskCount);
             }
-        }
+        });
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    printf("\nConverted %u map tiles (%u up to date) in %u ms\n", taskCount - skippedTasks, uint32(skippedTasks), GetMSTimeDiffToNow(stageStart));
+
+    for (uint32 z = 0; z < map_count; ++z)
+    {
+        std::bitset<(WDT_MAP_SIZE) * (WDT_MAP_SIZE)> tiles;
+        for (uint32 i = 0; i < WDT_MAP_SIZE * WDT_MAP_SIZE; ++i)
+            tiles[i] = existingTiles[z][i] != 0;
 
         if (FILE* tileList = fopen(Firelands::StringFormat("%s/maps/%03u.tilelist", output_path, map_ids[z].id).c_str(), "wb"))
         {
             fwrite(MAP_MAGIC, 1, strlen(MAP_MAGIC), tileList);
             fwrite(&MAP_VERSION_MAGIC, sizeof(MAP_VERSION_MAGIC), 1, tileList);
             fwrite(&build, sizeof(build), 1, tileList);
-            fwrite(existingTiles.to_string().c_str(), 1, existingTiles.size(), tileList);
+            fwrite(tiles.to_string().c_str(), 1, tiles.size(), tileList);
             fclose(tileList);
         }
     }
@@ -1519,8 +1630,10 @@ int main(int argc, char* arg[])
         }
 
         printf("\n");
+        uint32 dbcStart = getMSTime();
         ExtractDBCFiles(i);
         ExtractDB2Files(i);
+        printf("Extracted %s dbc and db2 files in %u ms\n", Locales[i], GetMSTimeDiffToNow(dbcStart));
 
         if (FirstLocale < 0)
         {
@@ -1547,7 +1660,9 @@ int main(int argc, char* arg[])
         LoadCommonMPQFiles(build);
 
         // Extract cameras
+        uint32 cameraStart = getMSTime();
         ExtractCameraFiles();
+        printf("Extracted cameras in %u ms\n", GetMSTimeDiffToNow(cameraStart));
 
         // Close MPQs
         SFileCloseArchive(WorldMpq);
@@ -1563,7 +1678,9 @@ int main(int argc, char* arg[])
         LoadCommonMPQFiles(build);
 
         // Extract maps
+        uint32 mapStart = getMSTime();
         ExtractMapsFromMpq(build);
+        printf("Extracted maps in %u ms\n", GetMSTimeDiffToNow(mapStart));
 
         // Close MPQs
         SFileCloseArchive(WorldMpq);
@@ -19,9 +19,13 @@
 
 #include "loadlib.h"
 #include <cstdio>
+#include <mutex>
 
 u_map_fcc MverMagic = { {'R','E','V','M'} };
 
+// StormLib archive handles must not be used by several threads at once
+static std::mutex MpqReadLock;
+
 ChunkedFile::ChunkedFile()
 {
     data = 0;
@@ -36,27 +40,27 @@ ChunkedFile::~ChunkedFile()
 bool ChunkedFile::loadFile(HANDLE mpq, std::string const& fileName, bool log)
 {
     free();
-    HANDLE file;
-    if (!SFileOpenFileEx(mpq, fileName.c_str(), SFILE_OPEN_PATCHED_FILE, &file))
     {
-        if (log)
-            printf("No such file %s\n", fileName.c_str());
-        return false;
-    }
+        std::lock_guard<std::mutex> lock(MpqReadLock);
+        HANDLE file;
+        if (!SFileOpenFileEx(mpq, fileName.c_str(), SFILE_OPEN_PATCHED_FILE, &file))
+        {
+            if (log)
+                printf("No such file %s\n", fileName.c_str());
+            return false;
+        }
 
-    data_size = SFileGetFileSize(file, nullptr);
-    data = new uint8[data_size];
-    SFileReadFile(file, data, data_size, nullptr/*bytesRead*/, nullptr);
+        data_size = SFileGetFileSize(file, nullptr);
+        data = new uint8[data_size];
+        SFileReadFile(file, data, data_size, nullptr/*bytesRead*/, nullptr);
+        SFileCloseFile(file);
+    }
 
     parseChunks();
     if (prepareLoadedData())
-    {
-        SFileCloseFile(file);
         return true;
-    }
 
     printf("Error loading %s\n", fileName.c_str());
-    SFileCloseFile(file);
     free();
 
     return false;
@@ -102,6 +102,9 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
     if (cacheable)
         dirfileCache = new std::vector<ADTOutputCache>();
 
+    // models referenced by this tile, converted together before the first spawn needs them
+    std::vector<std::string> modelPaths;
+
     while (!_file.isEof())
     {
         char fourcc[5];
@@ -135,7 +138,7 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
 
                     ModelInstanceNames.emplace_back(s);
 
-                    ExtractSingleModel(path);
+                    modelPaths.push_back(std::move(path));
 
                     p += strlen(p) + 1;
                 }
@@ -159,7 +162,7 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
 
                     WmoInstanceNames.emplace_back(s);
 
-                    ExtractSingleWmo(path);
+                    modelPaths.push_back(std::move(path));
 
                     p += strlen(p) + 1;
                 }
@@ -169,6 +172,9 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
         //======================
         else if (!strcmp(fourcc, "MDDF"))
         {
+            ExtractModels(modelPaths);
+            modelPaths.clear();
+
             if (size)
             {
                 uint32 doodadCount = size / sizeof(ADT::MDDF);
@@ -184,6 +190,9 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
         }
         else if (!strcmp(fourcc,"MODF"))
         {
+            ExtractModels(modelPaths);
+            modelPaths.clear();
+
             if (size)
             {
                 uint32 mapObjectCount = size / sizeof(ADT::MODF);
@@ -203,6 +212,8 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
         _file.seek(nextpos);
     }
 
+    ExtractModels(modelPaths);
+
     _file.close();
     fclose(dirfile);
     return true;
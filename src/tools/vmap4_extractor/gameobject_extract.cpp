@@ -45,14 +45,24 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
+    bool result = true;
+    switch (BeginModelOutput(output, result))
+    {
+        case MODEL_OUTPUT_DONE:
+            return result;
+        case MODEL_OUTPUT_EXISTS:
+            EndModelOutput(output, true);
+            return true;
+        default:
+            break;
+    }
 
+    // write to a temporary file first so an interrupted run never leaves a truncated model behind
+    std::string tempOutput = output + ".tmp";
     Model mdl(originalName);
-    if (!mdl.open())
-        return false;
-
-    return mdl.ConvertToVMAPModel(output.c_str());
+    result = mdl.open() && mdl.ConvertToVMAPModel(tempOutput.c_str()) && !rename(tempOutput.c_str(), output.c_str());
+    EndModelOutput(output, result);
+    return result;
 }
 
 extern HANDLE LocaleMpq;
@@ -81,6 +91,8 @@ void ExtractGameobjectModels()
 
     fwrite(VMAP::RAW_VMAP_MAGIC, 1, 8, model_list);
 
+    std::vector<uint32> displayIds;
+    std::vector<std::string> paths;
     for (DBCFile::Iterator it = dbc.begin(); it != dbc.end(); ++it)
     {
         path = it->getString(1);
@@ -96,27 +108,31 @@ void ExtractGameobjectModels()
         if (!ch_ext)
             continue;
 
-        bool result = false;
-        uint8 isWmo = 0;
-        if (!strcmp(ch_ext, ".wmo"))
-        {
-            isWmo = 1;
-            result = ExtractSingleWmo(path);
-        }
-        else if (!strcmp(ch_ext, ".mdl"))   // TODO: extract .mdl files, if needed
+        if (!strcmp(ch_ext, ".mdl"))   // TODO: extract .mdl files, if needed
             continue;
-        else //if (!strcmp(ch_ext, ".mdx") || !strcmp(ch_ext, ".m2"))
-            result = ExtractSingleModel(path);
-
-        if (result)
-        {
-            uint32 displayId = it->getUInt(0);
-            uint32 path_length = strlen(name);
-            fwrite(&displayId, sizeof(uint32), 1, model_list);
-            fwrite(&isWmo, sizeof(uint8), 1, model_list);
-            fwrite(&path_length, sizeof(uint32), 1, model_list);
-            fwrite(name, sizeof(char), path_length, model_list);
-        }
+
+        displayIds.push_back(it->getUInt(0));
+        paths.push_back(path);
+    }
+
+    // models are converted in parallel, the list is written in dbc order afterwards
+    std::vector<uint8> results;
+    ExtractModels(paths, &results);
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        if (!results[i])
+            continue;
+
+        // model extraction renames .mdx files to .m2 in place
+        char const* name = GetPlainName(paths[i].c_str());
+        uint8 isWmo = !strcmp(GetExtension(const_cast<char*>(name)), ".wmo") ? 1 : 0;
+        uint32 displayId = displayIds[i];
+        uint32 path_length = strlen(name);
+        fwrite(&displayId, sizeof(uint32), 1, model_list);
+        fwrite(&isWmo, sizeof(uint8), 1, model_list);
+        fwrite(&path_length, sizeof(uint32), 1, model_list);
+        fwrite(name, sizeof(char), path_length, model_list);
     }
 
     fclose(model_list);
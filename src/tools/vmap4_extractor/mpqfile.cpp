@@ -1,14 +1,19 @@
 #include "mpqfile.h"
 #include <deque>
 #include <cstdio>
+#include <mutex>
 #include "StormLib.h"
 
+// StormLib archive handles must not be used by several threads at once
+static std::mutex MpqReadLock;
+
 MPQFile::MPQFile(HANDLE mpq, char const* filename, bool warnNoExist /*= true*/) :
     eof(false),
     buffer(0),
     pointer(0),
     size(0)
 {
+    std::lock_guard<std::mutex> lock(MpqReadLock);
     HANDLE file;
     if (!SFileOpenFileEx(mpq, filename, SFILE_OPEN_PATCHED_FILE, &file))
     {
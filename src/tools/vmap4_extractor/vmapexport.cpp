@@ -22,6 +22,9 @@
 #include "mpqfile.h"
 #include "vmapexport.h"
 #include "Banner.h"
+#include "ProducerConsumerQueue.h"
+#include "Timer.h"
+#include "Util.h"
 #include <sys/stat.h>
 
 #ifdef _WIN32
@@ -35,9 +38,13 @@
 #undef min
 #undef max
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -54,6 +61,8 @@ HANDLE WorldMpq = nullptr;
 HANDLE LocaleMpq = nullptr;
 
 uint32 CONF_TargetBuild = 15595;              // 4.3.4.15595
+uint32 CONF_threads = std::max(1u, std::thread::hardware_concurrency());
+bool CONF_resume = false;                     // keep models converted by an earlier run
 
 // List MPQ for extract maps from
 char const* CONF_mpq_list[]=
@@ -124,6 +133,12 @@ char output_path[128]=".";
 char input_path[1024]=".";
 bool preciseVectorData = false;
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+std::mutex WmoDoodadsLock;
+
+// Model output files handled during this run, -1 while a thread is still converting
+std::unordered_map<std::string, int8> ModelOutputs;
+std::mutex ModelOutputsLock;
+std::condition_variable ModelOutputsCondition;
 
 // Constants
 
@@ -260,6 +275,135 @@ bool FileExists(char const* file)
     return false;
 }
 
+ModelOutputState BeginModelOutput(std::string const& outputPath, bool& result)
+{
+    std::unique_lock<std::mutex> lock(ModelOutputsLock);
+    auto itr = ModelOutputs.find(outputPath);
+    if (itr == ModelOutputs.end())
+    {
+        ModelOutputs.emplace(outputPath, -1);
+        return FileExists(outputPath.c_str()) ? MODEL_OUTPUT_EXISTS : MODEL_OUTPUT_CONVERT;
+    }
+
+    // another thread is converting this model, wait for its result
+    ModelOutputsCondition.wait(lock, [&outputPath]() { return ModelOutputs[outputPath] >= 0; });
+    result = ModelOutputs[outputPath] != 0;
+    return MODEL_OUTPUT_DONE;
+}
+
+void EndModelOutput(std::string const& outputPath, bool result)
+{
+    {
+        std::lock_guard<std::mutex> lock(ModelOutputsLock);
+        ModelOutputs[outputPath] = result ? 1 : 0;
+    }
+
+    ModelOutputsCondition.notify_all();
+}
+
+class ModelExtractor
+{
+public:
+    ModelExtractor() : _cancelationToken(false), _pendingRequests(0) { }
+
+    ~ModelExtractor()
+    {
+        if (Activated())
+            Deactivate();
+    }
+
+    void Activate(uint32 numThreads)
+    {
+        for (uint32 i = 0; i < numThreads; ++i)
+            _workerThreads.push_back(std::thread(&ModelExtractor::WorkerThread, this));
+    }
+
+    void Deactivate()
+    {
+        _cancelationToken = true;
+        _queue.Cancel();
+
+        for (std::thread& thread : _workerThreads)
+            thread.join();
+
+        _workerThreads.clear();
+    }
+
+    bool Activated() const { return !_workerThreads.empty(); }
+
+    void Extract(std::vector<std::string>& paths, std::vector<uint8>& results)
+    {
+        results.assign(paths.size(), 0);
+
+        // no workers, convert in the calling thread in listed order
+        if (!Activated())
+        {
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                results[i] = ExtractModel(paths[i]);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _pendingRequests += paths.size();
+        }
+
+        for (std::size_t i = 0; i < paths.size(); ++i)
+            _queue.Push({ &paths[i], &results[i] });
+
+        std::unique_lock<std::mutex> lock(_lock);
+        _condition.wait(lock, [this]() { return _pendingRequests == 0; });
+    }
+
+private:
+    struct Request
+    {
+        std::string* Path;
+        uint8* Result;
+    };
+
+    static bool ExtractModel(std::string& path)
+    {
+        if (path.length() >= 4 && StringEqualI(std::string_view(path).substr(path.length() - 4), ".wmo"))
+            return ExtractSingleWmo(path);
+
+        return ExtractSingleModel(path);
+    }
+
+    void WorkerThread()
+    {
+        while (true)
+        {
+            Request request;
+            _queue.WaitAndPop(request);
+
+            if (_cancelationToken)
+                return;
+
+            *request.Result = ExtractModel(*request.Path);
+
+            std::lock_guard<std::mutex> lock(_lock);
+            if (--_pendingRequests == 0)
+                _condition.notify_all();
+        }
+    }
+
+    ProducerConsumerQueue<Request> _queue;
+    std::atomic<bool> _cancelationToken;
+    std::vector<std::thread> _workerThreads;
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::size_t _pendingRequests;
+};
+
+ModelExtractor sModelExtractor;
+
+void ExtractModels(std::vector<std::string>& paths, std::vector<uint8>* results /*= nullptr*/)
+{
+    std::vector<uint8> ignoredResults;
+    sModelExtractor.Extract(paths, results ? *results : ignoredResults);
+}
+
 bool ExtractWmo()
 {
     bool success = false;
@@ -286,38 +430,8 @@ bool ExtractWmo()
     return success;
 }
 
-bool ExtractSingleWmo(std::string& fname)
+static bool ConvertWmo(std::string const& fname, std::string& originalName, char const* plain_name, std::string const& localFile, bool reuseOutput)
 {
-    // Copy files from archive
-    std::string originalName = fname;
-
-    char szLocalFile[1024];
-    char* plain_name = GetPlainName(&fname[0]);
-    FixNameCase(plain_name, strlen(plain_name));
-    FixNameSpaces(plain_name, strlen(plain_name));
-    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
-
-    if (FileExists(szLocalFile))
-        return true;
-
-    int p = 0;
-    // Select root wmo files
-    char const* rchr = strrchr(plain_name, '_');
-    if (rchr != nullptr)
-    {
-        char cpy[4];
-        memcpy(cpy, rchr, 4);
-        for (int i = 0; i < 4; ++i)
-        {
-            int m = cpy[i];
-            if (isdigit(m))
-                p++;
-        }
-    }
-
-    if (p == 3)
-        return true;
-
     bool file_ok = true;
     WMORoot froot(originalName);
     if (!froot.open())
@@ -325,15 +439,28 @@ bool ExtractSingleWmo(std::string& fname)
         printf("Couldn't open RootWmo!\n");
         return true;
     }
-    FILE *output = fopen(szLocalFile,"wb");
-    if (!output)
+
+    // output left by an earlier run is kept, only the doodad data is read again for the map spawns
+    std::string tempFile = localFile + ".tmp";
+    FILE* output = nullptr;
+    if (!reuseOutput)
     {
-        printf("Couldn't open %s for writing!\n", szLocalFile);
-        return false;
+        output = fopen(tempFile.c_str(), "wb");
+        if (!output)
+        {
+            printf("Couldn't open %s for writing!\n", tempFile.c_str());
+            return false;
+        }
+
+        froot.ConvertToVMAPRootWmo(output);
     }
-    froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
-    std::swap(doodads, froot.DoodadData);
+
+    WMODoodadData* doodads;
+    {
+        std::lock_guard<std::mutex> lock(WmoDoodadsLock);
+        doodads = &WmoDoodads[plain_name];
+    }
+    std::swap(*doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     uint32 groupCount = 0;
     //printf("root has %d groups\n", froot->nGroups);
@@ -360,22 +487,26 @@ bool ExtractSingleWmo(std::string& fname)
             if (fgroup.ShouldSkip(&froot))
                 continue;
 
-            Wmo_nVertices += fgroup.ConvertToVMAPGroupWmo(output, preciseVectorData);
+            if (output)
+                Wmo_nVertices += fgroup.ConvertToVMAPGroupWmo(output, preciseVectorData);
             ++groupCount;
             for (uint16 groupReference : fgroup.DoodadReferences)
             {
-                if (groupReference >= doodads.Spawns.size())
+                if (groupReference >= doodads->Spawns.size())
                     continue;
 
-                uint32 doodadNameIndex = doodads.Spawns[groupReference].NameIndex;
+                uint32 doodadNameIndex = doodads->Spawns[groupReference].NameIndex;
                 if (froot.ValidDoodadNames.find(doodadNameIndex) == froot.ValidDoodadNames.end())
                     continue;
 
-                doodads.References.insert(groupReference);
+                doodads->References.insert(groupReference);
             }
         }
     }
 
+    if (!output)
+        return true;
+
     fseek(output, 8, SEEK_SET); // store the correct no of vertices
     fwrite(&Wmo_nVertices, sizeof(int), 1, output);
     fwrite(&groupCount, sizeof(uint32), 1, output);
@@ -383,10 +514,51 @@ bool ExtractSingleWmo(std::string& fname)
 
     // Delete the extracted file in the case of an error
     if (!file_ok)
-        remove(szLocalFile);
+        remove(tempFile.c_str());
+    else if (rename(tempFile.c_str(), localFile.c_str()))
+        printf("Couldn't move %s to %s!\n", tempFile.c_str(), localFile.c_str());
     return true;
 }
 
+bool ExtractSingleWmo(std::string& fname)
+{
+    // Copy files from archive
+    std::string originalName = fname;
+
+    char szLocalFile[1024];
+    char* plain_name = GetPlainName(&fname[0]);
+    FixNameCase(plain_name, strlen(plain_name));
+    FixNameSpaces(plain_name, strlen(plain_name));
+    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
+
+    int p = 0;
+    // Select root wmo files
+    char const* rchr = strrchr(plain_name, '_');
+    if (rchr != nullptr)
+    {
+        char cpy[4];
+        memcpy(cpy, rchr, 4);
+        for (int i = 0; i < 4; ++i)
+        {
+            int m = cpy[i];
+            if (isdigit(m))
+                p++;
+        }
+    }
+
+    if (p == 3)
+        return true;
+
+    bool result = true;
+    ModelOutputState state = BeginModelOutput(szLocalFile, result);
+    if (state == MODEL_OUTPUT_DONE)
+        return result;
+
+    result = ConvertWmo(fname, originalName, plain_name, szLocalFile, state == MODEL_OUTPUT_EXISTS);
+    EndModelOutput(szLocalFile, result);
+    return result;
+}
+
 void ParsMapFiles()
 {
     std::unordered_map<uint32, WDTFile> wdts;
@@ -493,6 +665,15 @@ bool processArgv(int argc, char ** argv, const char *versionString)
             if (i + 1 < argc)                            // all ok
                 CONF_TargetBuild = atoi(argv[i++ + 1]);
         }
+        else if (strcmp("-t",argv[i]) == 0)
+        {
+            if (i + 1 < argc)                            // all ok
+                CONF_threads = std::max(1, atoi(argv[i++ + 1]));
+        }
+        else if (strcmp("-r",argv[i]) == 0)
+        {
+            CONF_resume = true;
+        }
         else
         {
             result = false;
@@ -503,11 +684,13 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if (!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-r][-d <path>][-t <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
         printf("   -b : target build (default %u)\n", CONF_TargetBuild);
+        printf("   -t <threads>: number of threads converting models (default %u)\n", CONF_threads);
+        printf("   -r : resume, keep models converted by an earlier run and rebuild only the spawn data.\n");
         printf("   -? : This message.\n");
     }
 
@@ -544,7 +727,12 @@ int main(int argc, char ** argv)
         std::string sdir = std::string(szWorkDirWmo) + "/dir";
         std::string sdir_bin = std::string(szWorkDirWmo) + "/dir_bin";
         struct stat status;
-        if (!stat(sdir.c_str(), &status) || !stat(sdir_bin.c_str(), &status))
+        if (CONF_resume)
+        {
+            // spawn data is always rebuilt from scratch, unique object ids depend on processing order
+            remove(sdir_bin.c_str());
+        }
+        else if (!stat(sdir.c_str(), &status) || !stat(sdir_bin.c_str(), &status))
         {
             printf("Your output directory seems to be polluted, please use an empty directory!\n");
             printf("<press return to exit>");
@@ -579,8 +767,16 @@ int main(int argc, char ** argv)
         break;
     }
 
+    if (CONF_threads > 1)
+    {
+        printf("Using %u threads to convert models\n", CONF_threads);
+        sModelExtractor.Activate(CONF_threads);
+    }
+
     // Extract models, listed in GameObjectDisplayInfo.dbc
+    uint32 stageStart = getMSTime();
     ExtractGameobjectModels();
+    printf("Extracted gameobject models in %u ms\n", GetMSTimeDiffToNow(stageStart));
 
     //xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
     //map.dbc
@@ -617,9 +813,14 @@ int main(int argc, char ** argv)
             printf("Map - %s\n", m.name);
         }
 
+        stageStart = getMSTime();
         ParsMapFiles();
+        printf("Extracted map spawns and models in %u ms\n", GetMSTimeDiffToNow(stageStart));
     }
 
+    if (sModelExtractor.Activated())
+        sModelExtractor.Deactivate();
+
     SFileCloseArchive(LocaleMpq);
     SFileCloseArchive(WorldMpq);
 
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct WMODoodadData;
 
@@ -37,9 +38,23 @@ uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
 
 bool FileExists(const char * file);
 
+enum ModelOutputState
+{
+    MODEL_OUTPUT_CONVERT,   // caller converts the model and reports the result with EndModelOutput
+    MODEL_OUTPUT_EXISTS,    // output was left by an earlier run, caller reports the result with EndModelOutput
+    MODEL_OUTPUT_DONE       // model was already handled during this run, result is set
+};
+
+// Makes sure every model output file is written by exactly one thread
+ModelOutputState BeginModelOutput(std::string const& outputPath, bool& result);
+void EndModelOutput(std::string const& outputPath, bool result);
+
 bool ExtractSingleWmo(std::string& fname);
 bool ExtractSingleModel(std::string& fname);
 
+// Extracts wmo and m2 files on the model extraction threads and waits for all of them
+void ExtractModels(std::vector<std::string>& paths, std::vector<uint8>* results = nullptr);
+
 void ExtractGameobjectModels();
 
 #endif
@@ -0,0 +1,146 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch2/catch.hpp"
+#include "ConcurrentLookupTable.h"
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Character
+    {
+        uint64 Guid;
+        std::string Name;
+    };
+
+    struct GuidOf { uint64 const& operator()(Character const& c) const { return c.Guid; } };
+    struct NameOf { std::string const& operator()(Character const& c) const { return c.Name; } };
+}
+
+TEST_CASE("Values are found by the key they carry", "[ConcurrentLookupTable]")
+{
+    ConcurrentLookupTable<uint64, Character, GuidOf> byGuid;
+    ConcurrentLookupTable<std::string, Character, NameOf> byName;
+
+    std::deque<Character> characters;
+    for (uint64 i = 1; i <= 1000; ++i)
+    {
+        characters.push_back({ i, "Name" + std::to_string(i) });
+        REQUIRE(byGuid.Insert(&characters.back()));
+        REQUIRE(byName.Insert(&characters.back()));
+    }
+
+    REQUIRE(byGuid.Size() == 1000);
+    REQUIRE(byGuid.GetCapacity() >= 2000);
+    REQUIRE(byGuid.Find(500) == &characters[499]);
+    REQUIRE(byName.Find("Name500") == &characters[499]);
+    REQUIRE(byGuid.Find(1001) == nullptr);
+    REQUIRE(byName.Find("Name1001") == nullptr);
+
+    Character renamed = { 500, "Renamed" };
+    REQUIRE_FALSE(byGuid.Insert(&renamed));
+    REQUIRE(byGuid.Find(500) == &renamed);
+    REQUIRE(byGuid.Size() == 1000);
+
+    REQUIRE(byName.Remove("Name500") == &characters[499]);
+    REQUIRE(byName.Remove("Name500") == nullptr);
+    REQUIRE(byName.Find("Name500") == nullptr);
+    REQUIRE(byName.Find("Name501") == &characters[500]);
+    REQUIRE(byName.Size() == 999);
+
+    byName.Clear();
+    REQUIRE(byName.Size() == 0);
+    REQUIRE(byName.Find("Name1") == nullptr);
+}
+
+TEST_CASE("Tombstones are reused and cleaned up by rehashing", "[ConcurrentLookupTable]")
+{
+    ConcurrentLookupTable<uint64, Character, GuidOf> table;
+    table.Reserve(64);
+    std::size_t capacity = table.GetCapacity();
+
+    // churn far more values through the table than it has slots
+    std::deque<Character> characters;
+    for (uint64 i = 0; i < 100000; ++i)
+    {
+        characters.push_back({ i, std::string() });
+        table.Insert(&characters.back());
+        if (i >= 32)
+            REQUIRE(table.Remove(i - 32) == &characters[i - 32]);
+    }
+
+    REQUIRE(table.Size() == 32);
+    REQUIRE(table.GetCapacity() == capacity);
+    for (uint64 i = 100000 - 32; i < 100000; ++i)
+        REQUIRE(table.Find(i) == &characters[i]);
+
+    // every purge retired the table it replaced
+    REQUIRE(table.GetRetiredTableCount() > 0);
+    table.ReleaseRetiredTables();
+    REQUIRE(table.GetRetiredTableCount() == 0);
+    REQUIRE(table.GetCapacity() == capacity);
+    for (uint64 i = 100000 - 32; i < 100000; ++i)
+        REQUIRE(table.Find(i) == &characters[i]);
+}
+
+TEST_CASE("Lookups run concurrently with a writer", "[ConcurrentLookupTable]")
+{
+    ConcurrentLookupTable<uint64, Character, GuidOf> table;
+    std::deque<Character> characters;
+    for (uint64 i = 0; i < 20000; ++i)
+        characters.push_back({ i, std::string() });
+
+    // the first half is always present, the second half is added and removed while readers look up everything
+    for (uint64 i = 0; i < 10000; ++i)
+        table.Insert(&characters[i]);
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint32> errors(0);
+    std::vector<std::thread> readers;
+    for (uint32 t = 0; t < 4; ++t)
+        readers.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                for (uint64 i = 0; i < 20000; ++i)
+                {
+                    Character* c = table.Find(i);
+                    if ((i < 10000 && c != &characters[i]) || (c && c->Guid != i))
+                        ++errors;
+                }
+            }
+        });
+
+    for (uint32 round = 0; round < 20; ++round)
+    {
+        for (uint64 i = 10000; i < 20000; ++i)
+            table.Insert(&characters[i]);
+        for (uint64 i = 10000; i < 20000; ++i)
+            table.Remove(i);
+    }
+
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(table.Size() == 10000);
+}
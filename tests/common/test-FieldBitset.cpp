@@ -0,0 +1,163 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "FieldBitset.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+TEST_CASE("Set, reset and test bits", "[FieldBitset]")
+{
+    FieldBitset bits(300);
+    REQUIRE(bits.FindNext(0) == FieldBitset::NPOS);
+
+    bits.Set(0);
+    bits.Set(63);
+    bits.Set(64);
+    bits.Set(299);
+    REQUIRE(bits.Test(63));
+    REQUIRE_FALSE(bits.Test(62));
+
+    bits.Reset(63);
+    REQUIRE_FALSE(bits.Test(63));
+
+    bits.Clear();
+    REQUIRE(bits.FindNext(0) == FieldBitset::NPOS);
+}
+
+TEST_CASE("FindNext walks set bits in order", "[FieldBitset]")
+{
+    FieldBitset bits(1000);
+    std::vector<uint32> expected = { 0, 1, 63, 64, 255, 256, 511, 700, 999 };
+    for (uint32 index : expected)
+        bits.Set(index);
+
+    std::vector<uint32> found;
+    for (uint32 index = bits.FindNext(0); index != FieldBitset::NPOS; index = bits.FindNext(index + 1))
+        found.push_back(index);
+
+    REQUIRE(found == expected);
+}
+
+TEST_CASE("Wide operations match per bit results", "[FieldBitset]")
+{
+    uint32 const fieldCount = 777;
+    std::mt19937 rng(42);
+
+    FieldBitset a(fieldCount), b(fieldCount), c(fieldCount);
+    std::vector<uint32> values(fieldCount);
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        if (rng() % 3 == 0)
+            a.Set(i);
+        if (rng() % 2 == 0)
+            b.Set(i);
+        if (rng() % 17 == 0)
+            c.Set(i);
+        values[i] = rng() % 4 == 0 ? 0 : rng();
+    }
+
+    SECTION("AssignAndOr")
+    {
+        FieldBitset result(fieldCount);
+        result.AssignAndOr(a, b, c);
+        for (uint32 i = 0; i < fieldCount; ++i)
+            REQUIRE(result.Test(i) == ((a.Test(i) && b.Test(i)) || c.Test(i)));
+    }
+
+    SECTION("Or")
+    {
+        FieldBitset result(a);
+        result.Or(c);
+        for (uint32 i = 0; i < fieldCount; ++i)
+            REQUIRE(result.Test(i) == (a.Test(i) || c.Test(i)));
+    }
+
+    SECTION("AssignNonZero")
+    {
+        FieldBitset result(fieldCount);
+        result.AssignNonZero(values.data(), fieldCount);
+        for (uint32 i = 0; i < fieldCount; ++i)
+            REQUIRE(result.Test(i) == (values[i] != 0));
+    }
+}
+
+TEST_CASE("Resize keeps storage and clears bits", "[FieldBitset]")
+{
+    FieldBitset bits(1000);
+    bits.Set(900);
+    bits.Resize(100);
+    REQUIRE(bits.GetFieldCount() == 100);
+    REQUIRE(bits.FindNext(0) == FieldBitset::NPOS);
+
+    bits.Resize(1000);
+    REQUIRE_FALSE(bits.Test(900));
+}
+
+// Values update selection for a player sized object (PLAYER_END is about 1300 fields)
+// with a handful of changed fields: per field flag/byte checks against the bitset path
+TEST_CASE("Values update field selection", "[.][benchmark][FieldBitset]")
+{
+    uint32 const fieldCount = 1300;
+    uint32 const visibleFlag = 0x1;
+    uint32 const notifyFlag = 0x100;
+    int const iterations = 100000;
+
+    std::mt19937 rng(7);
+    std::vector<uint32> flags(fieldCount);
+    for (uint32& flag : flags)
+        flag = rng() % 4 == 0 ? 0x2 : (rng() % 50 == 0 ? notifyFlag : visibleFlag);
+
+    std::vector<uint8> changedBytes(fieldCount, 0);
+    FieldBitset changed(fieldCount), visible(fieldCount), notify(fieldCount), fields(fieldCount);
+    for (uint32 i = 0; i < 8; ++i)
+    {
+        uint32 index = rng() % fieldCount;
+        changedBytes[index] = 1;
+        changed.Set(index);
+    }
+    for (uint32 i = 0; i < fieldCount; ++i)
+    {
+        if (flags[i] & visibleFlag)
+            visible.Set(i);
+        if (flags[i] & notifyFlag)
+            notify.Set(i);
+    }
+
+    uint64 scalarSum = 0, bitsetSum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        for (uint32 index = 0; index < fieldCount; ++index)
+            if ((notifyFlag & flags[index]) || (changedBytes[index] && (flags[index] & visibleFlag)))
+                scalarSum += index;
+    auto scalarTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fields.AssignAndOr(changed, visible, notify);
+        for (uint32 index = fields.FindNext(0); index < fieldCount; index = fields.FindNext(index + 1))
+            bitsetSum += index;
+    }
+    auto bitsetTime = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(scalarSum == bitsetSum);
+    WARN("per field scan: " << std::chrono::duration_cast<std::chrono::nanoseconds>(scalarTime).count() / iterations << " ns/update, "
+        << "bitset scan: " << std::chrono::duration_cast<std::chrono::nanoseconds>(bitsetTime).count() / iterations << " ns/update");
+}
@@ -0,0 +1,87 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch2/catch.hpp"
+#include "LatencyHistogram.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("Latencies are bucketed by power of two", "[LatencyHistogram]")
+{
+    REQUIRE(LatencyHistogram::GetBucketIndex(0) == 0);
+    REQUIRE(LatencyHistogram::GetBucketIndex(1) == 1);
+    REQUIRE(LatencyHistogram::GetBucketIndex(3) == 2);
+    REQUIRE(LatencyHistogram::GetBucketIndex(4) == 3);
+    REQUIRE(LatencyHistogram::GetBucketIndex(1000) == 10);
+    REQUIRE(LatencyHistogram::GetBucketIndex(UI64LIT(0xFFFFFFFFFFFFFFFF)) == LatencyHistogram::BUCKET_COUNT - 1);
+
+    LatencyHistogram histogram;
+    for (uint64 i = 1; i <= 100; ++i)
+        histogram.Record(i);
+    histogram.Record(5000);
+
+    LatencyHistogram::Snapshot snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.Count == 101);
+    REQUIRE(snapshot.TotalMicroseconds == 5050 + 5000);
+    REQUIRE(snapshot.MaxMicroseconds == 5000);
+    REQUIRE(snapshot.GetAverage() == 99);
+    REQUIRE(snapshot.GetPercentile(50) == 63);
+    REQUIRE(snapshot.GetPercentile(99) == 127);
+    REQUIRE(snapshot.GetPercentile(100) == 5000);
+}
+
+TEST_CASE("Taking a snapshot starts a new interval", "[LatencyHistogram]")
+{
+    LatencyHistogram histogram;
+    histogram.Record(10);
+    histogram.Record(20);
+
+    LatencyHistogram::Snapshot first = histogram.TakeSnapshot();
+    REQUIRE(first.Count == 2);
+    REQUIRE(first.MaxMicroseconds == 20);
+    REQUIRE(histogram.GetCount() == 0);
+
+    histogram.Record(3);
+    LatencyHistogram::Snapshot second = histogram.TakeSnapshot();
+    REQUIRE(second.Count == 1);
+    REQUIRE(second.MaxMicroseconds == 3);
+    REQUIRE(LatencyHistogram::Snapshot().GetPercentile(99) == 0);
+}
+
+TEST_CASE("Concurrent recording loses no samples", "[LatencyHistogram]")
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < 8; ++t)
+        threads.emplace_back([&histogram, t]()
+        {
+            for (uint32 i = 0; i < 10000; ++i)
+                histogram.Record(t * 100 + i % 7);
+        });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    LatencyHistogram::Snapshot snapshot = histogram.GetSnapshot();
+    uint64 bucketed = 0;
+    for (uint64 count : snapshot.Buckets)
+        bucketed += count;
+
+    REQUIRE(snapshot.Count == 80000);
+    REQUIRE(bucketed == 80000);
+    REQUIRE(snapshot.MaxMicroseconds == 706);
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "PeekableMPSCQueue.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Item
+    {
+        explicit Item(int value) : Value(value) { }
+        int Value;
+    };
+
+    struct OddFilter
+    {
+        bool Process(Item* item) const { return (item->Value % 2) != 0; }
+    };
+}
+
+TEST_CASE("Dequeue keeps insertion order", "[PeekableMPSCQueue]")
+{
+    PeekableMPSCQueue<Item> queue;
+    for (int i = 0; i < 4; ++i)
+        queue.Enqueue(new Item(i));
+
+    REQUIRE(queue.Size() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        Item* item = nullptr;
+        REQUIRE(queue.Dequeue(item));
+        REQUIRE(item->Value == i);
+        delete item;
+    }
+
+    Item* item = nullptr;
+    REQUIRE_FALSE(queue.Dequeue(item));
+    REQUIRE(queue.Size() == 0);
+}
+
+TEST_CASE("Rejected item stays at the front", "[PeekableMPSCQueue]")
+{
+    PeekableMPSCQueue<Item> queue;
+    queue.Enqueue(new Item(1));
+    queue.Enqueue(new Item(2));
+    queue.Enqueue(new Item(3));
+
+    OddFilter filter;
+    Item* item = nullptr;
+    REQUIRE(queue.Dequeue(item, filter));
+    REQUIRE(item->Value == 1);
+    delete item;
+
+    REQUIRE_FALSE(queue.Dequeue(item, filter));
+    REQUIRE(queue.Size() == 2);
+
+    REQUIRE(queue.Dequeue(item));
+    REQUIRE(item->Value == 2);
+    delete item;
+
+    REQUIRE(queue.Dequeue(item, filter));
+    REQUIRE(item->Value == 3);
+    delete item;
+}
+
+TEST_CASE("Requeued items are processed first", "[PeekableMPSCQueue]")
+{
+    PeekableMPSCQueue<Item> queue;
+    queue.Enqueue(new Item(1));
+    queue.Enqueue(new Item(2));
+    queue.Enqueue(new Item(3));
+
+    std::vector<Item*> taken(2);
+    REQUIRE(queue.Dequeue(taken[0]));
+    REQUIRE(queue.Dequeue(taken[1]));
+
+    queue.Requeue(taken.begin(), taken.end());
+    REQUIRE(queue.Size() == 3);
+
+    for (int i = 1; i <= 3; ++i)
+    {
+        Item* item = nullptr;
+        REQUIRE(queue.Dequeue(item));
+        REQUIRE(item->Value == i);
+        delete item;
+    }
+}
+
+TEST_CASE("Concurrent producers", "[PeekableMPSCQueue]")
+{
+    constexpr int Producers = 4;
+    constexpr int ItemsPerProducer = 10000;
+
+    PeekableMPSCQueue<Item> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < Producers; ++p)
+        producers.emplace_back([&queue, p]()
+        {
+            for (int i = 0; i < ItemsPerProducer; ++i)
+                queue.Enqueue(new Item(p * ItemsPerProducer + i));
+        });
+
+    std::vector<int> lastSeen(Producers, -1);
+    int received = 0;
+    while (received < Producers * ItemsPerProducer)
+    {
+        Item* item = nullptr;
+        if (!queue.Dequeue(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // items of a single producer must come out in the order they were queued
+        int producer = item->Value / ItemsPerProducer;
+        REQUIRE(item->Value > lastSeen[producer]);
+        lastSeen[producer] = item->Value;
+        delete item;
+        ++received;
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    REQUIRE(queue.Size() == 0);
+}
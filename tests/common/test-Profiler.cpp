@@ -0,0 +1,91 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch2/catch.hpp"
+#include "Profiler.h"
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    std::size_t CountOccurrences(std::string const& haystack, std::string const& needle)
+    {
+        std::size_t count = 0;
+        for (std::size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+            ++count;
+        return count;
+    }
+
+    std::string WriteTrace()
+    {
+        std::ostringstream stream;
+        sProfiler->WriteChromeTrace(stream);
+        return stream.str();
+    }
+}
+
+TEST_CASE("Zones are only recorded while started", "[Profiler]")
+{
+    sProfiler->Stop();
+    {
+        ProfilerZone zone("ProfilerTest::Stopped");
+    }
+
+    sProfiler->Start(16);
+    {
+        ProfilerZone zone("ProfilerTest::Outer", 571);
+        ProfilerZone inner("ProfilerTest::Inner");
+    }
+    sProfiler->Stop();
+
+    std::string trace = WriteTrace();
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(CountOccurrences(trace, "ProfilerTest::Stopped") == 0);
+    REQUIRE(CountOccurrences(trace, "ProfilerTest::Outer") == 1);
+    REQUIRE(CountOccurrences(trace, "ProfilerTest::Inner") == 1);
+    REQUIRE(trace.find("\"args\":{\"arg\":571}") != std::string::npos);
+}
+
+TEST_CASE("Ring buffers keep the newest zones of each thread", "[Profiler]")
+{
+    sProfiler->Start(8);
+
+    for (uint32 i = 0; i < 20; ++i)
+        ProfilerZone zone("ProfilerTest::Main");
+
+    std::thread worker([]()
+    {
+        sProfiler->SetThreadName("ProfilerTest worker");
+        for (uint32 i = 0; i < 5; ++i)
+            ProfilerZone zone("ProfilerTest::Worker", i + 1);
+    });
+    worker.join();
+
+    sProfiler->Stop();
+
+    std::string trace = WriteTrace();
+    REQUIRE(CountOccurrences(trace, "ProfilerTest::Main") == 8);
+    REQUIRE(CountOccurrences(trace, "ProfilerTest::Worker") == 5);
+    REQUIRE(trace.find("ProfilerTest worker") != std::string::npos);
+    // the worker exited, its zones are still there
+    REQUIRE(trace.find("\"args\":{\"arg\":5}") != std::string::npos);
+
+    // restarting drops what was recorded before
+    sProfiler->Start(8);
+    sProfiler->Stop();
+    REQUIRE(CountOccurrences(WriteTrace(), "ProfilerTest::") == 0);
+}
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "catch2/catch.hpp"
+#include "RatingBucketQueue.h"
+#include <chrono>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Team
+    {
+        uint32 Id;
+        uint32 Rating;
+        uint32 JoinTime;
+    };
+
+    // the linear scan over the queue in join order the bucketed queue replaces
+    Team* FindOldestLinear(std::list<Team*> const& queue, uint32 minRating, uint32 maxRating, uint32 now, uint32 maxWaitTime, uint32 skipId)
+    {
+        for (Team* team : queue)
+            if (team->Id != skipId && ((team->Rating >= minRating && team->Rating <= maxRating) || getMSTimeDiff(team->JoinTime, now) > maxWaitTime))
+                return team;
+        return nullptr;
+    }
+}
+
+TEST_CASE("Oldest value in rating range", "[RatingBucketQueue]")
+{
+    Team a{ 1, 1500, 100 }, b{ 2, 1520, 200 }, c{ 3, 2200, 300 }, d{ 4, 1490, 400 };
+    RatingBucketQueue<Team> queue(64);
+    for (Team* team : { &a, &b, &c, &d })
+        queue.Add(team, team->Rating, team->JoinTime);
+
+    REQUIRE(queue.Size() == 4);
+    REQUIRE(queue.FindOldest(1350, 1650, 400, 1000) == &a);
+    REQUIRE(queue.FindOldest(2000, 2300, 400, 1000) == &c);
+    REQUIRE(queue.FindOldest(0, 1000, 400, 1000) == nullptr);
+
+    // waited long enough to ignore rating
+    REQUIRE(queue.FindOldest(0, 1000, 400, 250) == &a);
+    REQUIRE(queue.FindOldest(2000, 2300, 400, 250) == &a);
+
+    REQUIRE(queue.FindOldest(1350, 1650, 400, 1000, [&a](Team* team) { return team == &a; }) == &b);
+
+    REQUIRE(queue.Remove(&a));
+    REQUIRE_FALSE(queue.Remove(&a));
+    REQUIRE_FALSE(queue.Contains(&a));
+    REQUIRE(queue.FindOldest(1350, 1650, 400, 1000) == &b);
+
+    queue.Clear();
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.FindOldest(0, 10000, 2000, 0) == nullptr);
+}
+
+TEST_CASE("Rating is discarded after long uptimes", "[RatingBucketQueue]")
+{
+    uint32 const discardTimer = 60000;
+    RatingBucketQueue<Team> queue(64);
+
+    // joined after 2^31 ms of uptime, about 24.8 days
+    Team a{ 1, 1500, 0x80000000 + 1000 };
+    queue.Add(&a, a.Rating, a.JoinTime);
+    REQUIRE(queue.FindOldest(2500, 2800, a.JoinTime + discardTimer, discardTimer) == nullptr);
+    REQUIRE(queue.FindOldest(2500, 2800, a.JoinTime + discardTimer + 1, discardTimer) == &a);
+
+    // and across the wrap of the 32 bit game time after about 49.7 days
+    Team b{ 2, 1500, 0xFFFFFFFF - 1000 };
+    queue.Clear();
+    queue.Add(&b, b.Rating, b.JoinTime);
+    REQUIRE(queue.FindOldest(2500, 2800, 30000, discardTimer) == nullptr);
+    REQUIRE(queue.FindOldest(2500, 2800, 70000, discardTimer) == &b);
+}
+
+TEST_CASE("Rated arena queue stress", "[RatingBucketQueue]")
+{
+    uint32 const teamCount = 5000;
+    uint32 const maxRatingDifference = 150;
+
+    std::mt19937 rng(1234);
+    std::normal_distribution<double> ratingDist(1600.0, 350.0);
+
+    std::vector<Team> teams(teamCount);
+    std::list<Team*> linear;
+    RatingBucketQueue<Team> bucketed;
+
+    uint32 now = 0;
+    uint32 matches = 0;
+    for (uint32 i = 0; i < teamCount; ++i)
+    {
+        now += rng() % 50;
+        teams[i] = { i + 1, uint32(std::max(0.0, ratingDist(rng))), now };
+        linear.push_back(&teams[i]);
+        bucketed.Add(&teams[i], teams[i].Rating, teams[i].JoinTime);
+
+        // every join triggers a queue update around the joining team's rating
+        // and every 100 joins a periodic update uses the longest waiting team's rating
+        uint32 rating = (i % 100) ? teams[i].Rating : linear.front()->Rating;
+        uint32 minRating = rating > maxRatingDifference ? rating - maxRatingDifference : 0;
+        uint32 maxRating = rating + maxRatingDifference;
+        uint32 const discardTimer = 60000;
+
+        Team* first = FindOldestLinear(linear, minRating, maxRating, now, discardTimer, 0);
+        REQUIRE(bucketed.FindOldest(minRating, maxRating, now, discardTimer) == first);
+        if (!first)
+            continue;
+
+        Team* second = FindOldestLinear(linear, minRating, maxRating, now, discardTimer, first->Id);
+        REQUIRE(bucketed.FindOldest(minRating, maxRating, now, discardTimer, [first](Team* team) { return team->Id == first->Id; }) == second);
+        if (!second)
+            continue;
+
+        ++matches;
+        linear.remove(first);
+        linear.remove(second);
+        REQUIRE(bucketed.Remove(first));
+        REQUIRE(bucketed.Remove(second));
+    }
+
+    REQUIRE(matches > 0);
+    REQUIRE(bucketed.Size() == linear.size());
+}
+
+TEST_CASE("Rated arena queue benchmark", "[.][benchmark][RatingBucketQueue]")
+{
+    uint32 const teamCount = 20000;
+    uint32 const lookups = 20000;
+
+    std::mt19937 rng(42);
+    std::normal_distribution<double> ratingDist(1600.0, 350.0);
+
+    std::vector<Team> teams(teamCount);
+    std::list<Team*> linear;
+    RatingBucketQueue<Team> bucketed;
+    for (uint32 i = 0; i < teamCount; ++i)
+    {
+        // a queue stuck with far outliers at its front, the worst case for the linear scan
+        teams[i] = { i + 1, i < teamCount / 2 ? 4000 + i % 500 : uint32(std::max(0.0, ratingDist(rng))), i };
+        linear.push_back(&teams[i]);
+        bucketed.Add(&teams[i], teams[i].Rating, teams[i].JoinTime);
+    }
+
+    std::vector<uint32> ratings(lookups);
+    for (uint32& rating : ratings)
+        rating = uint32(std::max(150.0, ratingDist(rng)));
+
+    auto measure = [&](auto&& find)
+    {
+        uintptr_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 rating : ratings)
+            sink += reinterpret_cast<uintptr_t>(find(rating - 150, rating + 150));
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(sink != 1);
+        return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(elapsed).count() / lookups;
+    };
+
+    double linearUs = measure([&](uint32 minRating, uint32 maxRating) { return FindOldestLinear(linear, minRating, maxRating, teamCount, 0xFFFFFFFF, 0); });
+    double bucketedUs = measure([&](uint32 minRating, uint32 maxRating) { return bucketed.FindOldest(minRating, maxRating, teamCount, 0xFFFFFFFF); });
+
+    WARN("linear scan: " << linearUs << " us per lookup, rating buckets: " << bucketedUs << " us per lookup");
+}
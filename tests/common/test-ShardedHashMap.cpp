@@ -0,0 +1,172 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch2/catch.hpp"
+#include "ShardedHashMap.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Values can be found until removed", "[ShardedHashMap]")
+{
+    ShardedHashMap<uint64, int*> map;
+    int a = 1, b = 2;
+
+    map.Insert(10, &a);
+    map.Insert(11, &b);
+    REQUIRE(map.Size() == 2);
+    REQUIRE(map.Find(10) == &a);
+    REQUIRE(map.Find(11) == &b);
+    REQUIRE(map.Find(12) == nullptr);
+
+    map.Insert(10, &b);
+    REQUIRE(map.Find(10) == &b);
+    REQUIRE(map.Size() == 2);
+
+    REQUIRE(map.Remove(10));
+    REQUIRE_FALSE(map.Remove(10));
+    REQUIRE(map.Find(10) == nullptr);
+    REQUIRE(map.Size() == 1);
+
+    map.Clear();
+    REQUIRE(map.Size() == 0);
+}
+
+TEST_CASE("Sequential keys are spread over all shards", "[ShardedHashMap]")
+{
+    std::set<std::size_t> shards;
+    for (uint64 key = 1; key <= 1024; ++key)
+        shards.insert(ShardedHashMap<uint64, int, 64>::GetShardIndex(key));
+
+    REQUIRE(shards.size() == 64);
+}
+
+TEST_CASE("Lookups see a consistent value while another thread writes", "[ShardedHashMap]")
+{
+    ShardedHashMap<uint64, uint64> map;
+    for (uint64 key = 0; key < 1000; ++key)
+        map.Insert(key, key * 2);
+
+    std::atomic<bool> stop(false);
+    std::thread writer([&]()
+    {
+        for (uint64 i = 0; i < 20000; ++i)
+        {
+            uint64 key = 1000 + i % 1000;
+            if (i % 2)
+                map.Remove(key);
+            else
+                map.Insert(key, key * 2);
+        }
+        stop = true;
+    });
+
+    uint64 const missing = UI64LIT(0xFFFFFFFFFFFFFFFF);
+    std::vector<std::thread> readers;
+    std::atomic<uint32> mismatches(0);
+    for (uint32 t = 0; t < 4; ++t)
+        readers.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                for (uint64 key = 0; key < 2000; ++key)
+                {
+                    uint64 value = map.Find(key, missing);
+                    if (value != missing && value != key * 2)
+                        ++mismatches;
+                }
+            }
+        });
+
+    writer.join();
+    for (std::thread& reader : readers)
+        reader.join();
+
+    REQUIRE(mismatches == 0);
+    for (uint64 key = 0; key < 1000; ++key)
+        REQUIRE(map.Find(key) == key * 2);
+}
+
+// Player lookups by guid from many map update threads while the world thread adds and
+// removes players: one shared_mutex guarded map against the sharded map
+TEST_CASE("Concurrent guid lookups", "[.][benchmark][ShardedHashMap]")
+{
+    uint32 const threadCount = std::max(16u, std::thread::hardware_concurrency());
+    uint64 const playerCount = 3000;
+    uint32 const lookupsPerThread = 500000;
+
+    struct SingleLockMap
+    {
+        std::shared_mutex Lock;
+        std::unordered_map<uint64, uint64> Map;
+
+        void Insert(uint64 key, uint64 value) { std::unique_lock<std::shared_mutex> lock(Lock); Map[key] = value; }
+        void Remove(uint64 key) { std::unique_lock<std::shared_mutex> lock(Lock); Map.erase(key); }
+        uint64 Find(uint64 key) { std::shared_lock<std::shared_mutex> lock(Lock); auto itr = Map.find(key); return itr != Map.end() ? itr->second : 0; }
+    };
+
+    auto run = [&](auto& map)
+    {
+        for (uint64 key = 1; key <= playerCount; ++key)
+            map.Insert(key, key);
+
+        std::atomic<bool> stop(false);
+        std::thread writer([&]()
+        {
+            // logins and logouts
+            for (uint64 i = 0; !stop; ++i)
+            {
+                uint64 key = playerCount + 1 + i % 100;
+                map.Insert(key, key);
+                map.Remove(key);
+            }
+        });
+
+        std::atomic<uint64> found(0);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> readers;
+        for (uint32 t = 0; t < threadCount; ++t)
+            readers.emplace_back([&, t]()
+            {
+                uint64 hits = 0;
+                for (uint32 i = 0; i < lookupsPerThread; ++i)
+                    if (map.Find(1 + (i * 7919 + t * 104729) % playerCount))
+                        ++hits;
+                found += hits;
+            });
+
+        for (std::thread& reader : readers)
+            reader.join();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        stop = true;
+        writer.join();
+
+        REQUIRE(found == uint64(threadCount) * lookupsPerThread);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / lookupsPerThread;
+    };
+
+    SingleLockMap singleLock;
+    ShardedHashMap<uint64, uint64> sharded;
+    auto singleLockTime = run(singleLock);
+    auto shardedTime = run(sharded);
+
+    WARN(threadCount << " threads, single lock: " << singleLockTime << " ns/lookup, sharded: " << shardedTime << " ns/lookup");
+}
@@ -0,0 +1,205 @@
+/*
+* This file is part of the FirelandsCore Project. See AUTHORS file for Copyright information
+*
+* This program is free software; you can redistribute it and/or modify it
+* under the terms of the GNU Affero General Public License as published by the
+* Free Software Foundation; either version 2 of the License, or (at your
+* option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+* more details.
+*
+* You should have received a copy of the GNU Affero General Public License along
+* with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch2/catch.hpp"
+#include "Socket.h"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/read.hpp>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    class LoopbackSocket : public Socket<LoopbackSocket>
+    {
+    public:
+        explicit LoopbackSocket(tcp::socket&& socket) : Socket(std::move(socket)) { }
+
+        void Start() override { }
+
+    protected:
+        void ReadHandler() override { }
+    };
+
+    struct Loopback
+    {
+        Loopback() : Acceptor(Context, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)), Client(Context)
+        {
+            Client.connect(Acceptor.local_endpoint());
+            Server = std::make_unique<tcp::socket>(Context);
+            Acceptor.accept(*Server);
+        }
+
+        boost::asio::io_context Context;
+        tcp::acceptor Acceptor;
+        tcp::socket Client;
+        std::unique_ptr<tcp::socket> Server;
+    };
+
+    // world packet sizes seen on a busy map, mostly small movement and update packets
+    std::size_t GetPacketSize(uint32 i)
+    {
+        static std::size_t const sizes[] = { 24, 40, 40, 64, 96, 150, 220, 512, 40, 1300 };
+        return sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+    }
+
+    // drains everything the server side sends until expectedBytes arrived
+    std::thread StartReader(tcp::socket& client, std::size_t expectedBytes)
+    {
+        return std::thread([&client, expectedBytes]()
+        {
+            std::vector<uint8> buffer(0x10000);
+            std::size_t received = 0;
+            boost::system::error_code error;
+            while (received < expectedBytes && !error)
+                received += client.read_some(boost::asio::buffer(buffer), error);
+        });
+    }
+}
+
+TEST_CASE("Queued buffers arrive complete and in order", "[Socket]")
+{
+    Loopback loopback;
+    std::shared_ptr<LoopbackSocket> socket = std::make_shared<LoopbackSocket>(std::move(*loopback.Server));
+
+    std::vector<uint8> expected;
+    auto shared = std::make_shared<std::vector<uint8> const>(3000, uint8(0xAB));
+    for (uint32 i = 0; i < 500; ++i)
+    {
+        if (i % 50 == 0)
+        {
+            socket->QueuePacket(shared);
+            expected.insert(expected.end(), shared->begin(), shared->end());
+            continue;
+        }
+
+        MessageBuffer buffer(GetPacketSize(i));
+        std::vector<uint8> data(GetPacketSize(i), uint8(i));
+        buffer.Write(data.data(), data.size());
+        socket->QueuePacket(std::move(buffer));
+        expected.insert(expected.end(), data.begin(), data.end());
+    }
+
+    std::vector<uint8> received(expected.size());
+    std::thread reader([&]()
+    {
+        boost::system::error_code error;
+        boost::asio::read(loopback.Client, boost::asio::buffer(received), error);
+    });
+
+    while (socket->GetWrittenBytes() < expected.size())
+    {
+        socket->Update();
+        loopback.Context.poll();
+        loopback.Context.restart();
+    }
+
+    reader.join();
+    REQUIRE(received == expected);
+    REQUIRE(socket->GetWriteCallCount() < 500);
+    socket->CloseSocket();
+}
+
+// One map tick worth of packets queued on a world connection and flushed by the network
+// thread: one write_some per buffer as before against gathering the queue into one call
+TEST_CASE("Loopback write throughput", "[.][benchmark][Socket]")
+{
+    uint32 const ticks = 2000;
+    uint32 const packetsPerTick = 100;
+
+    std::size_t bytesPerTick = 0;
+    for (uint32 i = 0; i < packetsPerTick; ++i)
+        bytesPerTick += GetPacketSize(i);
+    std::size_t const totalBytes = bytesPerTick * ticks;
+
+    auto queueTick = [&](auto&& queue)
+    {
+        for (uint32 i = 0; i < packetsPerTick; ++i)
+        {
+            MessageBuffer buffer(GetPacketSize(i));
+            std::vector<uint8> data(GetPacketSize(i), uint8(i));
+            buffer.Write(data.data(), data.size());
+            queue(std::move(buffer));
+        }
+    };
+
+    // one buffer per write call
+    uint64 singleCalls = 0;
+    std::chrono::steady_clock::duration singleTime;
+    {
+        Loopback loopback;
+        std::thread reader = StartReader(loopback.Client, totalBytes);
+        std::deque<MessageBuffer> queue;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 tick = 0; tick < ticks; ++tick)
+        {
+            queueTick([&](MessageBuffer&& buffer) { queue.push_back(std::move(buffer)); });
+            while (!queue.empty())
+            {
+                MessageBuffer& buffer = queue.front();
+                ++singleCalls;
+                buffer.ReadCompleted(loopback.Server->write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize())));
+                if (!buffer.GetActiveSize())
+                    queue.pop_front();
+            }
+        }
+        reader.join();
+        singleTime = std::chrono::steady_clock::now() - start;
+    }
+
+    // Socket<T> gathering the queue
+    uint64 gatherCalls = 0;
+    std::chrono::steady_clock::duration gatherTime;
+    {
+        Loopback loopback;
+        std::shared_ptr<LoopbackSocket> socket = std::make_shared<LoopbackSocket>(std::move(*loopback.Server));
+        std::thread reader = StartReader(loopback.Client, totalBytes);
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 tick = 0; tick < ticks; ++tick)
+        {
+            queueTick([&](MessageBuffer&& buffer) { socket->QueuePacket(std::move(buffer)); });
+            socket->Update();
+            loopback.Context.poll();
+            loopback.Context.restart();
+        }
+
+        while (socket->GetWrittenBytes() < totalBytes)
+        {
+            socket->Update();
+            loopback.Context.poll();
+            loopback.Context.restart();
+        }
+
+        reader.join();
+        gatherTime = std::chrono::steady_clock::now() - start;
+        gatherCalls = socket->GetWriteCallCount();
+        REQUIRE(socket->GetWrittenBytes() == totalBytes);
+        socket->CloseSocket();
+    }
+
+    auto megabytesPerSecond = [&](std::chrono::steady_clock::duration elapsed)
+    {
+        return double(totalBytes) / (1024.0 * 1024.0) / std::chrono::duration<double>(elapsed).count();
+    };
+
+    WARN(totalBytes << " bytes in " << ticks * packetsPerTick << " packets, one write per buffer: " << singleCalls << " calls, "
+        << totalBytes / singleCalls << " bytes/call, " << megabytesPerSecond(singleTime) << " MB/s; gathered: " << gatherCalls << " calls, "
+        << totalBytes / gatherCalls << " bytes/call, " << megabytesPerSecond(gatherTime) << " MB/s");
+}